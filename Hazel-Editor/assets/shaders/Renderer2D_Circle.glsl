@@ -6,7 +6,10 @@ layout(location = 1) in vec2 a_LocalPosition;
 layout(location = 2) in float a_Thickness;
 layout(location = 3) in float a_Fade;
 layout(location = 4) in vec4 a_Color;
+// Only the editor variant writes entity ids, for mouse picking
+#ifdef HZ_ENTITY_ID
 layout(location = 5) in int a_EntityId;
+#endif
 
 layout (std140, binding = 0) uniform Camera
 {
@@ -22,7 +25,9 @@ struct VertexOutput
 };
 
 layout (location = 0) out VertexOutput Output;
+#ifdef HZ_ENTITY_ID
 layout (location = 4) out flat int v_EntityId;
+#endif
 
 void main()
 {
@@ -31,7 +36,9 @@ void main()
 	Output.Fade = a_Fade;
 	Output.Color = a_Color;
 
+#ifdef HZ_ENTITY_ID
 	v_EntityId = a_EntityId;
+#endif
 
 	gl_Position = u_ViewProjection * vec4(a_WorldPosition, 1.0);
 }
@@ -40,7 +47,9 @@ void main()
 #version 450 core
 
 layout(location = 0) out vec4 o_Color;
+#ifdef HZ_ENTITY_ID
 layout(location = 1) out int o_EntityId;
+#endif
 
 struct VertexOutput
 {
@@ -51,7 +60,9 @@ struct VertexOutput
 };
 
 layout (location = 0) in VertexOutput Input;
+#ifdef HZ_ENTITY_ID
 layout (location = 4) in flat int v_EntityId;
+#endif
 
 void main()
 {
@@ -68,5 +79,7 @@ void main()
 	o_Color = Input.Color;
 	o_Color.a *= alpha;
 
+#ifdef HZ_ENTITY_ID
 	o_EntityId = v_EntityId;
+#endif
 }
\ No newline at end of file
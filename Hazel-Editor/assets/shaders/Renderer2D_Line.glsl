@@ -3,7 +3,10 @@
 
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec4 a_Color;
+// Only the editor variant writes entity ids, for mouse picking
+#ifdef HZ_ENTITY_ID
 layout(location = 2) in int a_EntityId;
+#endif
 
 layout (std140, binding = 0) uniform Camera
 {
@@ -16,12 +19,16 @@ struct VertexOutput
 };
 
 layout (location = 0) out VertexOutput Output;
+#ifdef HZ_ENTITY_ID
 layout (location = 1) out flat int v_EntityId;
+#endif
 
 void main()
 {
 	Output.Color = a_Color;
+#ifdef HZ_ENTITY_ID
 	v_EntityId = a_EntityId;
+#endif
 
 	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
 }
@@ -30,7 +37,9 @@ void main()
 #version 450 core
 
 layout(location = 0) out vec4 o_Color;
+#ifdef HZ_ENTITY_ID
 layout(location = 1) out int o_EntityId;
+#endif
 
 struct VertexOutput
 {
@@ -38,10 +47,14 @@ struct VertexOutput
 };
 
 layout (location = 0) in VertexOutput Input;
+#ifdef HZ_ENTITY_ID
 layout (location = 1) in flat int v_EntityId;
+#endif
 
 void main()
 {
 	o_Color = Input.Color;
+#ifdef HZ_ENTITY_ID
 	o_EntityId = v_EntityId;
+#endif
 }
\ No newline at end of file
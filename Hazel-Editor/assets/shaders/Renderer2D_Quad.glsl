@@ -6,7 +6,10 @@ layout(location = 1) in vec4 a_Color;
 layout(location = 2) in vec2 a_TexCoord;
 layout(location = 3) in uint a_TexIndex;
 layout(location = 4) in float a_TilingFactor;
+// Only the editor variant writes entity ids, for mouse picking
+#ifdef HZ_ENTITY_ID
 layout(location = 5) in int a_EntityId;
+#endif
 
 layout(std140, binding = 0) uniform Camera
 {
@@ -22,7 +25,9 @@ struct VertexOutput
 
 layout (location = 0) out VertexOutput Output;
 layout (location = 3) out flat uint v_TexIndex;
+#ifdef HZ_ENTITY_ID
 layout (location = 4) out flat int v_EntityId;
+#endif
 
 void main()
 {
@@ -31,7 +36,9 @@ void main()
 	Output.TilingFactor = a_TilingFactor;
 	v_TexIndex = a_TexIndex;
 
+#ifdef HZ_ENTITY_ID
 	v_EntityId = a_EntityId;
+#endif
 
 	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
 }
@@ -40,7 +47,9 @@ void main()
 #version 450 core
 
 layout(location = 0) out vec4 o_Color;
+#ifdef HZ_ENTITY_ID
 layout(location = 1) out int o_EntityId;
+#endif
 
 struct VertexOutput
 {
@@ -51,7 +60,9 @@ struct VertexOutput
 
 layout (location = 0) in VertexOutput Input;
 layout (location = 3) in flat uint v_TexIndex;
+#ifdef HZ_ENTITY_ID
 layout (location = 4) in flat int v_EntityId;
+#endif
 
 layout (binding = 0) uniform sampler2D u_Textures[32];
 
@@ -99,5 +110,7 @@ void main()
 		discard;
 
 	o_Color = texColor;
+#ifdef HZ_ENTITY_ID
 	o_EntityId = v_EntityId;
+#endif
 }
\ No newline at end of file
@@ -4,7 +4,11 @@
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec4 a_Color;
 layout(location = 2) in vec2 a_TexCoord;
-layout(location = 3) in int a_EntityId;
+layout(location = 3) in uint a_AtlasIndex;
+// Only the editor variant writes entity ids, for mouse picking
+#ifdef HZ_ENTITY_ID
+layout(location = 4) in int a_EntityId;
+#endif
 
 layout(std140, binding = 0) uniform Camera
 {
@@ -18,14 +22,20 @@ struct VertexOutput
 };
 
 layout (location = 0) out VertexOutput Output;
-layout (location = 2) out flat int v_EntityId;
+layout (location = 2) out flat uint v_AtlasIndex;
+#ifdef HZ_ENTITY_ID
+layout (location = 3) out flat int v_EntityId;
+#endif
 
 void main()
 {
 	Output.Color = a_Color;
 	Output.TexCoord = a_TexCoord;
+	v_AtlasIndex = a_AtlasIndex;
 
+#ifdef HZ_ENTITY_ID
 	v_EntityId = a_EntityId;
+#endif
 
 	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
 }
@@ -34,7 +44,9 @@ void main()
 #version 450 core
 
 layout(location = 0) out vec4 o_Color;
+#ifdef HZ_ENTITY_ID
 layout(location = 1) out int o_EntityId;
+#endif
 
 struct VertexOutput
 {
@@ -43,14 +55,23 @@ struct VertexOutput
 };
 
 layout (location = 0) in VertexOutput Input;
-layout (location = 2) in flat int v_EntityId;
+layout (location = 2) in flat uint v_AtlasIndex;
+#ifdef HZ_ENTITY_ID
+layout (location = 3) in flat int v_EntityId;
+#endif
 
-layout (binding = 0) uniform sampler2D u_FontAtlas;
+layout (binding = 0) uniform sampler2D u_FontAtlases[16];
 
-float screenPxRange()
+vec3 sampleAtlas(sampler2D atlas, out vec2 atlasSize)
+{
+	atlasSize = vec2(textureSize(atlas, 0));
+	return texture(atlas, Input.TexCoord).rgb;
+}
+
+float screenPxRange(vec2 atlasSize)
 {
 	const float pxRange = 2.0;
-	vec2 unitRange = vec2(pxRange) / vec2(textureSize(u_FontAtlas, 0));
+	vec2 unitRange = vec2(pxRange) / atlasSize;
 	vec2 screenTexSize = vec2(1.0) / fwidth(Input.TexCoord);
 	return max(0.5 * dot(unitRange, screenTexSize), 1.0);
 }
@@ -62,9 +83,31 @@ float median(float r, float g, float b)
 
 void main()
 {
-	vec3 msd = texture(u_FontAtlas, Input.TexCoord).rgb;
+	vec3 msd = vec3(0.0);
+	vec2 atlasSize = vec2(1.0);
+
+	switch(v_AtlasIndex)
+	{
+		case  0: msd = sampleAtlas(u_FontAtlases[ 0], atlasSize); break;
+		case  1: msd = sampleAtlas(u_FontAtlases[ 1], atlasSize); break;
+		case  2: msd = sampleAtlas(u_FontAtlases[ 2], atlasSize); break;
+		case  3: msd = sampleAtlas(u_FontAtlases[ 3], atlasSize); break;
+		case  4: msd = sampleAtlas(u_FontAtlases[ 4], atlasSize); break;
+		case  5: msd = sampleAtlas(u_FontAtlases[ 5], atlasSize); break;
+		case  6: msd = sampleAtlas(u_FontAtlases[ 6], atlasSize); break;
+		case  7: msd = sampleAtlas(u_FontAtlases[ 7], atlasSize); break;
+		case  8: msd = sampleAtlas(u_FontAtlases[ 8], atlasSize); break;
+		case  9: msd = sampleAtlas(u_FontAtlases[ 9], atlasSize); break;
+		case 10: msd = sampleAtlas(u_FontAtlases[10], atlasSize); break;
+		case 11: msd = sampleAtlas(u_FontAtlases[11], atlasSize); break;
+		case 12: msd = sampleAtlas(u_FontAtlases[12], atlasSize); break;
+		case 13: msd = sampleAtlas(u_FontAtlases[13], atlasSize); break;
+		case 14: msd = sampleAtlas(u_FontAtlases[14], atlasSize); break;
+		case 15: msd = sampleAtlas(u_FontAtlases[15], atlasSize); break;
+	}
+
 	float sd = median(msd.r, msd.g, msd.b);
-	float screenPxDistance = screenPxRange() * (sd - 0.5);
+	float screenPxDistance = screenPxRange(atlasSize) * (sd - 0.5);
 	float opacity = clamp(screenPxDistance + 0.5, 0.0, 1.0);
 
 	if (opacity == 0.0)
@@ -76,5 +119,7 @@ void main()
 	if (o_Color.a == 0.0)
 		discard;
 
+#ifdef HZ_ENTITY_ID
 	o_EntityId = v_EntityId;
+#endif
 }
\ No newline at end of file
@@ -5,14 +5,17 @@
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include "Hazel/Scene/SceneBinarySerializer.h"
 #include "Hazel/Scene/SceneSerializer.h"
 
 #include "Hazel/Scripting/ScriptEngine.h"
 
 #include "Hazel/Utils/PlatformUtils.h"
 
+#include "Hazel/Core/Timer.h"
 #include "Hazel/Math/Math.h"
 #include "Hazel/Renderer/Font.h"
+#include "Hazel/Renderer/TextureCache.h"
 
 namespace Hazel
 {
@@ -84,6 +87,8 @@ namespace Hazel
 			}
 		}
 
+		UpdateEntityPicking();
+
 		Renderer2D::ResetStats();
 		m_Framebuffer->Bind();
 		RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
@@ -212,6 +217,26 @@ namespace Hazel
 				ImGui::EndMenu();
 			}
 
+			if (ImGui::BeginMenu("Tools"))
+			{
+				const bool yamlScene = !m_ActiveScenePath.empty() && !SceneBinarySerializer::IsBinarySceneFile(m_ActiveScenePath);
+				if (ImGui::MenuItem("Convert Scene to Binary", nullptr, false, yamlScene))
+				{
+					FilePath binaryPath = m_ActiveScenePath;
+					binaryPath.replace_extension(SceneBinarySerializer::Extension);
+					if (SceneBinarySerializer::ConvertToBinary(m_ActiveScenePath, binaryPath))
+						HZ_INFO("Converted {0} to {1}", m_ActiveScenePath, binaryPath);
+				}
+
+				if (ImGui::MenuItem("Benchmark Scene Formats", nullptr, false, m_SceneState == SceneState::Edit))
+					BenchmarkSceneFormats();
+
+				if (ImGui::MenuItem("Build Texture Cache", nullptr, false, (bool)Project::GetActive()))
+					TextureCache::ImportDirectory(Project::GetAssetDirectory());
+
+				ImGui::EndMenu();
+			}
+
 			ImGui::EndMenuBar();
 		}
 
@@ -225,11 +250,13 @@ namespace Hazel
 		ImGui::Text("Circles: %d", stats.CircleCount);
 		ImGui::Text("Vertices: %d", stats.GetTotalVertexCount());
 		ImGui::Text("Indices: %d", stats.GetTotalIndexCount());
+		ImGui::Text("Vertex Data: %.1f KB", (float)stats.VertexBytes / 1024.0f);
 		ImGui::End();
 
 		ImGui::Begin("Settings");
 		ImGui::Checkbox("Show physics colliders", &m_ShowPhysicsColliders);
-		ImGui::Image((ImTextureID)s_Font->GetAtlasTexture()->GetRendererId(), { 512, 512 }, { 0, 1 }, { 1, 0 });
+		if (s_Font->IsLoaded())
+			ImGui::Image((ImTextureID)s_Font->GetAtlasTexture()->GetRendererId(), { 512, 512 }, { 0, 1 }, { 1, 0 });
 		ImGui::End();
 
 		ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2{ 0, 0 });
@@ -260,6 +287,13 @@ namespace Hazel
 			ImGui::EndDragDropTarget();
 		}
 
+		if (m_SceneLoader)
+		{
+			ImGui::SetCursorPos({ viewportMinRegion.x + 10.0f, viewportMinRegion.y + 10.0f });
+			const std::string label = fmt::format("Loading {0}... {1}/{2}", m_SceneLoader->GetFilePath().filename().string(), m_SceneLoader->GetLoadedEntityCount(), m_SceneLoader->GetEntityCount());
+			ImGui::ProgressBar(m_SceneLoader->GetProgress(), { 300.0f, 0.0f }, label.c_str());
+		}
+
 		// Gizmos
 		Entity selectedEntity = m_SceneHierarchyPanel.GetSelectedEntity();
 		if (selectedEntity && m_GizmoType != -1)
@@ -495,17 +529,12 @@ namespace Hazel
 	{
 		if (e.GetMouseButton() == Mouse::ButtonLeft)
 		{
-			if (m_ViewportHovered && !ImGuizmo::IsOver() && !Input::IsKeyPressed(Key::LeftAlt))
+			int32_t mouseX, mouseY;
+			if (m_ViewportHovered && !ImGuizmo::IsOver() && !Input::IsKeyPressed(Key::LeftAlt) && GetMouseViewportPosition(mouseX, mouseY))
 			{
-				int32_t pixelData = GetMouseOverPixelData();
-				if (pixelData != -1)
-				{
-					if (m_GizmoType == -1)
-						m_GizmoType = ImGuizmo::OPERATION::TRANSLATE;
-
-					m_SceneHierarchyPanel.SetSelectedEntity(Entity((entt::entity)pixelData, m_ActiveScene.get()));
-				}
-
+				// Reading the id back right away would wait for the GPU, the selection is applied when the copy lands
+				m_PickReadback = m_Framebuffer->ReadPixelsAsync(1, mouseX, mouseY);
+				m_PickScene = m_ActiveScene;
 			}
 		}
 
@@ -610,11 +639,13 @@ namespace Hazel
 
 		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
 		m_ActiveScenePath = FilePath();
+
+		AssetManager::EvictUnusedAssets();
 	}
 
 	void EditorLayer::OpenScene()
 	{
-		const std::optional<std::string> filepath = FileDialogs::OpenFile("Hazel Scene (*.hazel)\0*.hazel\0");
+		const std::optional<std::string> filepath = FileDialogs::OpenFile("Hazel Scene (*.hazel;*.hsb)\0*.hazel;*.hsb\0");
 		if (filepath)
 			OpenScene(*filepath);
 	}
@@ -624,21 +655,31 @@ namespace Hazel
 		if (m_SceneState != SceneState::Edit)
 			OnSceneStop();
 
-		if (path.extension().string() != ".hazel")
+		const bool binaryScene = SceneBinarySerializer::IsBinarySceneFile(path);
+		if (path.extension().string() != ".hazel" && !binaryScene)
 		{
 			HZ_WARN("Could not load {0} - not a scene file", path);
 			return;
 		} 
 
-		auto newScene = CreateRef<Scene>();
-		SceneSerializer serializer(newScene);
-		if (serializer.Deserialize(path))
+		// Replacing a pending load cancels it
+		m_SceneLoader = SceneLoader::LoadAsync(path, [this, path](const Ref<Scene>& scene, bool success)
 		{
-			m_EditorScene = newScene;
+			m_SceneLoader = nullptr;
+			if (!success)
+				return;
+
+			if (m_SceneState != SceneState::Edit)
+				OnSceneStop();
+
+			m_EditorScene = scene;
 			m_ActiveScene = m_EditorScene;
 			m_SceneHierarchyPanel.SetContext(m_ActiveScene);
 			m_ActiveScenePath = path;
-		}
+
+			// Textures only the previous scene used are freed, the ones both share were never reloaded
+			AssetManager::EvictUnusedAssets();
+		});
 	}
 
 	void EditorLayer::SaveScene()
@@ -651,7 +692,7 @@ namespace Hazel
 
 	void EditorLayer::SaveSceneAs()
 	{
-		const std::optional<std::string> filepath = FileDialogs::SaveFile("Hazel Scene (*.hazel)\0*.hazel\0");
+		const std::optional<std::string> filepath = FileDialogs::SaveFile("Hazel Scene (*.hazel)\0*.hazel\0Hazel Binary Scene (*.hsb)\0*.hsb\0");
 		if (filepath)
 		{
 			SerializeScene(*filepath);
@@ -663,14 +704,67 @@ namespace Hazel
 	{
 		HZ_CORE_ASSERT(!path.empty());
 
+		if (SceneBinarySerializer::IsBinarySceneFile(path))
+		{
+			SceneBinarySerializer(m_ActiveScene).Serialize(path);
+			return;
+		}
+
 		SceneSerializer serializer(m_ActiveScene);
 		serializer.Serialize(path);
 	}
 
-	int32_t EditorLayer::GetMouseOverPixelData() const
+	void EditorLayer::BenchmarkSceneFormats() const
 	{
-		m_Framebuffer->Bind();
+		const FilePath directory = std::filesystem::temp_directory_path();
+		const FilePath yamlPath = directory / "HazelSceneBenchmark.hazel";
+		const FilePath binaryPath = directory / "HazelSceneBenchmark.hsb";
+
+		struct Result
+		{
+			float SaveMillis = 0.0f, LoadMillis = 0.0f;
+			uint64_t FileSize = 0;
+			uint64_t PeakMemoryGrowth = 0;
+		};
+
+		// The peak working set can only grow, so the format expected to use less memory runs first
+		const auto run = [&](const FilePath& path, const auto& save, const auto& load)
+		{
+			Result result;
+			const uint64_t peakBefore = ProcessInfo::GetPeakMemoryUsage();
+
+			Timer timer;
+			save(path);
+			result.SaveMillis = timer.ElapsedMillis();
+
+			auto scene = CreateRef<Scene>();
+			timer.Reset();
+			load(scene, path);
+			result.LoadMillis = timer.ElapsedMillis();
+
+			result.FileSize = std::filesystem::file_size(path);
+			result.PeakMemoryGrowth = ProcessInfo::GetPeakMemoryUsage() - peakBefore;
+			return result;
+		};
+
+		const Result binary = run(binaryPath,
+			[this](const FilePath& path) { SceneBinarySerializer(m_EditorScene).Serialize(path); },
+			[](const Ref<Scene>& scene, const FilePath& path) { SceneBinarySerializer(scene).Deserialize(path); });
+
+		const Result yaml = run(yamlPath,
+			[this](const FilePath& path) { SceneSerializer(m_EditorScene).Serialize(path); },
+			[](const Ref<Scene>& scene, const FilePath& path) { SceneSerializer(scene).Deserialize(path); });
+
+		HZ_INFO("Scene format benchmark ({0} entities):", m_EditorScene->GetAllEntitiesWith<IdComponent>().size());
+		HZ_INFO("    YAML:   save {0:.2f}ms, load {1:.2f}ms, {2} bytes, peak memory +{3} KB", yaml.SaveMillis, yaml.LoadMillis, yaml.FileSize, yaml.PeakMemoryGrowth / 1024);
+		HZ_INFO("    Binary: save {0:.2f}ms, load {1:.2f}ms, {2} bytes, peak memory +{3} KB", binary.SaveMillis, binary.LoadMillis, binary.FileSize, binary.PeakMemoryGrowth / 1024);
+
+		std::filesystem::remove(yamlPath);
+		std::filesystem::remove(binaryPath);
+	}
 
+	bool EditorLayer::GetMouseViewportPosition(int32_t& outX, int32_t& outY) const
+	{
 		auto [mx, my] = ImGui::GetMousePos();
 		mx -= m_ViewportBounds[0].x;
 		my -= m_ViewportBounds[0].y;
@@ -680,10 +774,31 @@ namespace Hazel
 		const auto mouseX = (int32_t)mx;
 		const auto mouseY = (int32_t)my;
 
-		if (mouseX >= 0 && mouseY >= 0 && mouseX < (int32_t)viewportSize.x && mouseY < (int32_t)viewportSize.y)
-			return m_Framebuffer->ReadPixel(1, mouseX, mouseY);
+		if (mouseX < 0 || mouseY < 0 || mouseX >= (int32_t)viewportSize.x || mouseY >= (int32_t)viewportSize.y)
+			return false;
+
+		outX = mouseX;
+		outY = mouseY;
+		return true;
+	}
+
+	void EditorLayer::UpdateEntityPicking()
+	{
+		if (!m_PickReadback || !m_PickReadback->IsReady())
+			return;
+
+		const int32_t pixelData = m_PickReadback->GetPixels()[0];
+		const Ref<Scene> scene = std::move(m_PickScene);
+		m_PickReadback = nullptr;
+
+		// The scene may have been switched or the entity deleted while the id was in flight
+		if (pixelData == -1 || scene != m_ActiveScene || !scene->IsEntityValid((EntityId)pixelData))
+			return;
+
+		if (m_GizmoType == -1)
+			m_GizmoType = ImGuizmo::OPERATION::TRANSLATE;
 
-		return -1;
+		m_SceneHierarchyPanel.SetSelectedEntity(Entity((EntityId)pixelData, m_ActiveScene.get()));
 	}
 
 	void EditorLayer::OnScenePlay()
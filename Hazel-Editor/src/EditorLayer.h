@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Hazel.h>
+#include "Hazel/Scene/SceneLoader.h"
 #include "Panels/SceneHierarchyPanel.h"
 #include "Panels/ContentBrowserPanel.h"
 
@@ -35,8 +36,12 @@ namespace Hazel
 		void SaveScene();
 		void SaveSceneAs();
 		void SerializeScene(const FilePath& path) const;
+		void BenchmarkSceneFormats() const;
 
-		int32_t GetMouseOverPixelData() const;
+		// In framebuffer pixels, false if the mouse is outside of the viewport
+		bool GetMouseViewportPosition(int32_t& outX, int32_t& outY) const;
+		// Applies the click selection once its readback arrives
+		void UpdateEntityPicking();
 
 		void OnScenePlay();
 		void OnSceneSimulate();
@@ -49,9 +54,12 @@ namespace Hazel
 		void UI_ToolBar();
 	private:
 		Ref<Framebuffer> m_Framebuffer;
+		Ref<FramebufferReadback> m_PickReadback;
+		Ref<Scene> m_PickScene;
 		Ref<Scene> m_ActiveScene;
 		Ref<Scene> m_EditorScene;
 		FilePath m_ActiveScenePath;
+		Ref<SceneLoader> m_SceneLoader;
 		EditorCamera m_EditorCamera;
 
 		bool m_ViewportFocused = false, m_ViewportHovered = false;
@@ -26,6 +26,8 @@ namespace Hazel
 		spec.ScriptEngineConfig.CoreAssemblyPath = "Resources/Scripts/Hazel-ScriptCore.dll";
 		spec.ScriptEngineConfig.EnableDebugging = true;
 
+		spec.RendererConfig.EntityIds = true;
+
 		return new HazelEditor(spec);
 	}
 }
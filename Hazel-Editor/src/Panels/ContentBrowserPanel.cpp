@@ -1,22 +1,60 @@
 #include "ContentBrowserPanel.h"
 
 #include "Hazel/Project/Project.h"
+#include "Hazel/Renderer/ThumbnailCache.h"
 
 #include <imgui/imgui.h>
 
+#include <algorithm>
+
+#include "FileWatch.hpp"
+
 namespace Hazel
 {
 	namespace Fs = std::filesystem;
 
+	// Largest side of the generated thumbnails, the biggest cell the panel can show is 512
+	static constexpr uint32_t s_ThumbnailSize = 256;
+
+	namespace Utils
+	{
+		// Listings and thumbnails are keyed by this so every way of reaching a path maps to the same entry
+		static std::string GetPathKey(const FilePath& path)
+		{
+			std::string key = path.lexically_normal().generic_string();
+			while (key.size() > 1 && key.back() == '/')
+				key.pop_back();
+			return key;
+		}
+	}
+
 	ContentBrowserPanel::ContentBrowserPanel()
 		: m_BaseDirectory(Project::GetAssetDirectory()), m_CurrentDirectory(m_BaseDirectory)
 	{
 		m_DirectoryIcon = Texture2D::Create("Resources/Icons/ContentBrowser/DirectoryIcon.png");
 		m_FileIcon = Texture2D::Create("Resources/Icons/ContentBrowser/FileIcon.png");
+
+		// Scans are cheap but shouldn't wait behind thumbnails
+		m_ScanWorker = CreateScope<ThreadPool>(1);
+		m_ThumbnailWorkers = CreateScope<ThreadPool>();
+
+		m_FileWatcher = CreateScope<filewatch::FileWatch<std::string>>(m_BaseDirectory.string(), [this](const std::string& path, const filewatch::Event changeType)
+		{
+			OnFileSystemEvent(path, changeType);
+		});
+	}
+
+	ContentBrowserPanel::~ContentBrowserPanel()
+	{
+		m_FileWatcher.reset();
+		m_ScanWorker.reset();
+		m_ThumbnailWorkers.reset();
 	}
 
 	void ContentBrowserPanel::OnImGuiRender()
 	{
+		ProcessResults();
+
 		ImGui::Begin("Content Browser");
 
 		if (m_CurrentDirectory != m_BaseDirectory)
@@ -34,32 +72,44 @@ namespace Hazel
 
 		ImGui::Columns(columnCount, 0, false);
 
-		for (auto& directoryEntry : Fs::directory_iterator(m_CurrentDirectory))
+		// Entering a directory changes m_CurrentDirectory, which doesn't touch the listing being drawn
+		const std::vector<DirectoryItem>* listing = GetListing(m_CurrentDirectory);
+		if (listing)
 		{
-			const auto& path = directoryEntry.path();
-			std::string filenameString = path.filename().string();
+			for (const DirectoryItem& item : *listing)
+			{
+				ImGui::PushID(item.Filename.c_str());
 
-			ImGui::PushID(filenameString.c_str());
-			Ref<Texture2D> icon = directoryEntry.is_directory() ? m_DirectoryIcon : m_FileIcon;
-			ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));
-			ImGui::ImageButton((ImTextureID)(uint64_t)icon->GetRendererId(), { thumbnailSize, thumbnailSize }, { 0, 1 }, { 1, 0 });
+				// Only the thumbnails of items in view are requested, the position is all that's needed to know
+				const bool visible = ImGui::IsRectVisible({ thumbnailSize, thumbnailSize });
 
-			if (ImGui::BeginDragDropSource())
-			{
-				const wchar_t* itemPath = path.c_str();
-				ImGui::SetDragDropPayload("CONTENT_BROWSER_ITEM", itemPath, (wcslen(itemPath) + 1) * sizeof(wchar_t), ImGuiCond_Once);
-				ImGui::EndDragDropSource();
-			}
+				Ref<Texture2D> icon = item.IsDirectory ? m_DirectoryIcon : m_FileIcon;
+				if (item.IsImage && visible)
+				{
+					if (Ref<Texture2D> thumbnail = GetThumbnail(item))
+						icon = thumbnail;
+				}
+
+				ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));
+				ImGui::ImageButton((ImTextureID)(uint64_t)icon->GetRendererId(), { thumbnailSize, thumbnailSize }, { 0, 1 }, { 1, 0 });
+
+				if (ImGui::BeginDragDropSource())
+				{
+					const wchar_t* itemPath = item.Path.c_str();
+					ImGui::SetDragDropPayload("CONTENT_BROWSER_ITEM", itemPath, (wcslen(itemPath) + 1) * sizeof(wchar_t), ImGuiCond_Once);
+					ImGui::EndDragDropSource();
+				}
 
-			ImGui::PopStyleColor();
+				ImGui::PopStyleColor();
 
-			if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
-				if (directoryEntry.is_directory())
-					m_CurrentDirectory /= path.filename();
+				if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+					if (item.IsDirectory)
+						m_CurrentDirectory /= item.Path.filename();
 
-			ImGui::TextWrapped(filenameString.c_str());
-			ImGui::NextColumn();
-			ImGui::PopID();
+				ImGui::TextWrapped(item.Filename.c_str());
+				ImGui::NextColumn();
+				ImGui::PopID();
+			}
 		}
 
 		ImGui::Columns(1);
@@ -69,4 +119,127 @@ namespace Hazel
 
 		ImGui::End();
 	}
+
+	const std::vector<ContentBrowserPanel::DirectoryItem>* ContentBrowserPanel::GetListing(const FilePath& directory)
+	{
+		DirectoryListing& listing = m_Listings[Utils::GetPathKey(directory)];
+		if (!listing.Scanning && (!listing.Scanned || listing.Stale))
+			ScanDirectory(directory);
+
+		// A stale listing is still shown while it's scanned again
+		return listing.Scanned ? &listing.Items : nullptr;
+	}
+
+	void ContentBrowserPanel::ScanDirectory(const FilePath& directory)
+	{
+		DirectoryListing& listing = m_Listings[Utils::GetPathKey(directory)];
+		listing.Scanning = true;
+		listing.Stale = false;
+
+		m_ScanWorker->Submit([this, directory]
+		{
+			ScanResult result;
+			result.Directory = Utils::GetPathKey(directory);
+
+			std::error_code error;
+			for (const auto& entry : Fs::directory_iterator(directory, error))
+			{
+				DirectoryItem& item = result.Items.emplace_back();
+				item.Path = entry.path();
+				item.Filename = item.Path.filename().string();
+				item.IsDirectory = entry.is_directory(error);
+				item.IsImage = !item.IsDirectory && TextureCache::IsImageFile(item.Path);
+			}
+
+			if (error)
+				HZ_WARN("Could not list directory {0}", directory);
+
+			// Directories first, then by name
+			std::sort(result.Items.begin(), result.Items.end(), [](const DirectoryItem& a, const DirectoryItem& b)
+			{
+				if (a.IsDirectory != b.IsDirectory)
+					return a.IsDirectory;
+				return a.Filename < b.Filename;
+			});
+
+			std::scoped_lock lock(m_ResultsMutex);
+			m_ScanResults.push_back(std::move(result));
+		});
+	}
+
+	Ref<Texture2D> ContentBrowserPanel::GetThumbnail(const DirectoryItem& item)
+	{
+		const std::string key = Utils::GetPathKey(item.Path);
+		Thumbnail& thumbnail = m_Thumbnails[key];
+		if (thumbnail.Requested)
+			return thumbnail.Texture;
+
+		thumbnail.Requested = true;
+		m_ThumbnailWorkers->Submit([this, key, path = item.Path]
+		{
+			ThumbnailResult result;
+			result.Path = key;
+			result.Loaded = ThumbnailCache::Load(path, s_ThumbnailSize, result.Image);
+			if (!result.Loaded)
+				HZ_WARN("Could not generate a thumbnail for {0}", path);
+
+			std::scoped_lock lock(m_ResultsMutex);
+			m_ThumbnailResults.push_back(std::move(result));
+		});
+
+		return nullptr;
+	}
+
+	void ContentBrowserPanel::ProcessResults()
+	{
+		std::vector<ScanResult> scanResults;
+		std::vector<ThumbnailResult> thumbnailResults;
+		std::unordered_set<std::string> changedPaths;
+		{
+			std::scoped_lock lock(m_ResultsMutex);
+			scanResults.swap(m_ScanResults);
+			thumbnailResults.swap(m_ThumbnailResults);
+			changedPaths.swap(m_ChangedPaths);
+		}
+
+		for (ScanResult& result : scanResults)
+		{
+			DirectoryListing& listing = m_Listings[result.Directory];
+			listing.Items = std::move(result.Items);
+			listing.Scanned = true;
+			listing.Scanning = false;
+		}
+
+		for (ThumbnailResult& result : thumbnailResults)
+		{
+			// Dropped if the file changed after it was requested, a result for the new request follows anyway
+			const auto it = m_Thumbnails.find(result.Path);
+			if (it == m_Thumbnails.end() || !result.Loaded)
+				continue;
+
+			const TextureSpecification& specification = result.Image.Specification;
+			it->second.Texture = Texture2D::Create(specification);
+			it->second.Texture->SetSubData(result.Image.Data, 0, 0, specification.Width, specification.Height);
+		}
+
+		// Applied last so a scan that finished before the change was seen is still redone
+		for (const std::string& path : changedPaths)
+		{
+			if (const auto it = m_Listings.find(path); it != m_Listings.end())
+				it->second.Stale = true;
+
+			m_Thumbnails.erase(path);
+		}
+	}
+
+	void ContentBrowserPanel::OnFileSystemEvent(const std::string& path, filewatch::Event changeType)
+	{
+		// Runs on the watcher's thread. The path is relative to the asset directory, and both the item and the
+		// directory containing it are marked since it may be a directory itself
+		const FilePath filepath = m_BaseDirectory / path;
+
+		std::scoped_lock lock(m_ResultsMutex);
+		m_ChangedPaths.insert(Utils::GetPathKey(filepath));
+		m_ChangedPaths.insert(Utils::GetPathKey(filepath.parent_path()));
+	}
 }
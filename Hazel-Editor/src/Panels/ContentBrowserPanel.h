@@ -1,22 +1,100 @@
 #pragma once
 
 #include "Hazel/Core/FileSystem.h"
+#include "Hazel/Core/ThreadPool.h"
 
 #include "Hazel/Renderer/Texture.h"
+#include "Hazel/Renderer/TextureCache.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace filewatch
+{
+	enum class Event;
+	template<typename T> class FileWatch;
+}
 
 namespace Hazel
 {
+	// Directory listings are scanned on a worker thread and cached, a listing is only scanned again when the
+	// asset directory watcher reports a change inside it. Image files show a thumbnail instead of the file icon,
+	// thumbnails go through the ThumbnailCache on the thumbnail workers and are only requested once they are in view.
 	class ContentBrowserPanel
 	{
 	public:
 		ContentBrowserPanel();
-		~ContentBrowserPanel() = default;
+		~ContentBrowserPanel();
 
 		void OnImGuiRender();
 
+	private:
+		struct DirectoryItem
+		{
+			FilePath Path;
+			std::string Filename;
+			bool IsDirectory = false;
+			bool IsImage = false;
+		};
+
+		struct DirectoryListing
+		{
+			std::vector<DirectoryItem> Items;
+			bool Scanned = false;
+			bool Scanning = false;
+			// Changed since its last scan started, scanned again the next time it's shown
+			bool Stale = false;
+		};
+
+		struct Thumbnail
+		{
+			// Stays null if the image couldn't be loaded, it's only requested again once the file changes
+			Ref<Texture2D> Texture;
+			bool Requested = false;
+		};
+
+		struct ScanResult
+		{
+			std::string Directory;
+			std::vector<DirectoryItem> Items;
+		};
+
+		struct ThumbnailResult
+		{
+			std::string Path;
+			TextureImage Image;
+			bool Loaded = false;
+		};
+
+		// Returns the cached listing, scanning the directory if it's missing or stale. Nullptr until the first scan is done
+		const std::vector<DirectoryItem>* GetListing(const FilePath& directory);
+		void ScanDirectory(const FilePath& directory);
+
+		Ref<Texture2D> GetThumbnail(const DirectoryItem& item);
+
+		// Applies everything the workers and the watcher produced since the last frame
+		void ProcessResults();
+
+		void OnFileSystemEvent(const std::string& path, filewatch::Event changeType);
 	private:
 		FilePath m_BaseDirectory, m_CurrentDirectory;
 
 		Ref<Texture2D> m_DirectoryIcon, m_FileIcon;
+
+		std::unordered_map<std::string, DirectoryListing> m_Listings;
+		std::unordered_map<std::string, Thumbnail> m_Thumbnails;
+
+		// Filled by the workers and the watcher, emptied by ProcessResults
+		std::mutex m_ResultsMutex;
+		std::vector<ScanResult> m_ScanResults;
+		std::vector<ThumbnailResult> m_ThumbnailResults;
+		std::unordered_set<std::string> m_ChangedPaths;
+
+		Scope<filewatch::FileWatch<std::string>> m_FileWatcher;
+
+		// Last so they are stopped before anything their jobs write to is destroyed
+		Scope<ThreadPool> m_ScanWorker;
+		Scope<ThreadPool> m_ThumbnailWorkers;
 	};
 }
@@ -6,6 +6,7 @@
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include "Hazel/Asset/AssetManager.h"
 #include "Hazel/Scene/Components.h"
 #include "Hazel/Scripting/ScriptEngine.h"
 #include "Hazel/UI/UI.h"
@@ -17,21 +18,121 @@ namespace Hazel
 		SetContext(context);
 	}
 
+	SceneHierarchyPanel::~SceneHierarchyPanel()
+	{
+		SetContext(nullptr);
+	}
+
 	void SceneHierarchyPanel::SetContext(const Ref<Scene>& context)
 	{
+		if (m_Context)
+		{
+			auto& registry = m_Context->m_Registry;
+			registry.on_construct<TagComponent>().disconnect(this);
+			registry.on_update<TagComponent>().disconnect(this);
+			registry.on_destroy<TagComponent>().disconnect(this);
+		}
+
 		m_Context = context;
 		m_SelectionContext = {};
+
+		m_Rows.clear();
+		m_RowIndices.clear();
+		m_HasHoles = false;
+		m_FilterDirty = true;
+
+		if (!m_Context)
+			return;
+
+		auto& registry = m_Context->m_Registry;
+		for (const auto entity : registry.view<TagComponent>())
+		{
+			m_RowIndices[entity] = m_Rows.size();
+			m_Rows.push_back(entity);
+		}
+
+		registry.on_construct<TagComponent>().connect<&SceneHierarchyPanel::OnTagConstructed>(this);
+		registry.on_update<TagComponent>().connect<&SceneHierarchyPanel::OnTagUpdated>(this);
+		registry.on_destroy<TagComponent>().connect<&SceneHierarchyPanel::OnTagDestroyed>(this);
+	}
+
+	void SceneHierarchyPanel::OnTagConstructed(entt::registry& registry, entt::entity entity)
+	{
+		m_RowIndices[entity] = m_Rows.size();
+		m_Rows.push_back(entity);
+		m_FilterDirty = true;
+	}
+
+	void SceneHierarchyPanel::OnTagUpdated(entt::registry& registry, entt::entity entity)
+	{
+		m_FilterDirty = true;
+	}
+
+	void SceneHierarchyPanel::OnTagDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		const auto it = m_RowIndices.find(entity);
+		if (it == m_RowIndices.end())
+			return;
+
+		// Erasing here would be linear per entity when a whole scene is cleared
+		m_Rows[it->second] = entt::null;
+		m_RowIndices.erase(it);
+		m_HasHoles = true;
+		m_FilterDirty = true;
+	}
+
+	void SceneHierarchyPanel::UpdateRows()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (m_HasHoles)
+		{
+			m_Rows.erase(std::remove(m_Rows.begin(), m_Rows.end(), (EntityId)entt::null), m_Rows.end());
+			for (size_t i = 0; i < m_Rows.size(); i++)
+				m_RowIndices[m_Rows[i]] = i;
+
+			m_HasHoles = false;
+		}
+
+		if (!m_FilterDirty || !m_Filter.IsActive())
+			return;
+
+		m_FilteredRows.clear();
+		for (const EntityId entity : m_Rows)
+		{
+			// Matched in place, the tags aren't copied
+			const std::string& tag = m_Context->m_Registry.get<TagComponent>(entity).Tag;
+			if (m_Filter.PassFilter(tag.data(), tag.data() + tag.size()))
+				m_FilteredRows.push_back(entity);
+		}
+
+		m_FilterDirty = false;
 	}
 
 	void SceneHierarchyPanel::OnImGuiRender()
 	{
 		ImGui::Begin("Scene Hierarchy");
 
-		m_Context->m_Registry.each([&](auto entityId)
+		if (m_Filter.Draw("##Filter", -1.0f))
+			m_FilterDirty = true;
+
+		UpdateRows();
+
+		// Destroying an entity from a row only leaves a hole, so the list stays stable while it is drawn
+		const std::vector<EntityId>& rows = m_Filter.IsActive() ? m_FilteredRows : m_Rows;
+
+		ImGuiListClipper clipper;
+		clipper.Begin((int)rows.size());
+		while (clipper.Step())
 		{
-			Entity entity{ entityId, m_Context.get() };
-			DrawEntityNode(entity);
-		});
+			for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+			{
+				const EntityId entityId = rows[i];
+				if (m_Context->m_Registry.valid(entityId))
+					DrawEntityNode({ entityId, m_Context.get() });
+			}
+		}
+		clipper.End();
 
 		if (ImGui::IsMouseDown(0) && ImGui::IsWindowHovered())
 			m_SelectionContext = {};
@@ -198,13 +299,13 @@ namespace Hazel
 	{
 		if (entity.HasComponent<TagComponent>())
 		{
-			auto& tag = entity.GetComponent<TagComponent>().Tag;
+			const auto& tag = entity.GetComponent<TagComponent>().Tag;
 
 			char buffer[256] = {};
 			strcpy_s(buffer, sizeof buffer, tag.c_str());
 
 			if (ImGui::InputText("##Tag", buffer, sizeof buffer))
-				tag = std::string(buffer);
+				entity.PatchComponent<TagComponent>([&buffer](TagComponent& tc) { tc.Tag = buffer; });
 		}
 
 		ImGui::SameLine();
@@ -319,13 +420,13 @@ namespace Hazel
 				if (instance)
 				{
 					const auto& fields = instance->GetScriptClass()->GetFields();
-					for (const auto& [name, field] : fields)
+					for (const auto& field : fields)
 					{
 						if (field.Type == ScriptFieldType::Float)
 						{
-							float data = instance->GetFieldValue<float>(name);
-							if (ImGui::DragFloat(name.c_str(), &data))
-								instance->SetFieldValue(name, data);
+							float data = instance->GetFieldValue<float>(field.Handle);
+							if (ImGui::DragFloat(field.Name.c_str(), &data))
+								instance->SetFieldValue(field.Handle, data);
 						}
 					}
 				}
@@ -338,16 +439,16 @@ namespace Hazel
 					const auto& fields = entityClass->GetFields();
 					auto& entityFields = ScriptEngine::GetScriptFieldMap(entity);
 
-					for (const auto& [name, field] : fields)
+					for (const auto& field : fields)
 					{
 						// Field has been set in the editor
-						if (entityFields.find(name) != entityFields.end())
+						if (ScriptFieldInstance* fieldInstance = entityFields.Find(field))
 						{
 							if (field.Type == ScriptFieldType::Float)
 							{
-								ScriptFieldInstance& sfi = entityFields.at(name);
+								ScriptFieldInstance& sfi = *fieldInstance;
 								float data = sfi.GetValue<float>();
-								if (ImGui::DragFloat(name.c_str(), &data))
+								if (ImGui::DragFloat(field.Name.c_str(), &data))
 									sfi.SetValue(data);
 							}
 							
@@ -358,11 +459,9 @@ namespace Hazel
 							if (field.Type == ScriptFieldType::Float)
 							{
 								float data = 0.0f;
-								if (ImGui::DragFloat(name.c_str(), &data))
+								if (ImGui::DragFloat(field.Name.c_str(), &data))
 								{
-									ScriptFieldInstance& sfi = entityFields[name];
-									sfi.Field = field;
-									sfi.SetValue(data);
+									entityFields.Emplace(field).SetValue(data);
 								}
 							}
 						}
@@ -372,7 +471,7 @@ namespace Hazel
 			}
 		});
 
-		DrawComponent<SpriteRendererComponent>("Sprite Renderer", entity, [](SpriteRendererComponent& component)
+		DrawComponent<SpriteRendererComponent>("Sprite Renderer", entity, [&entity](SpriteRendererComponent& component)
 		{
 			ImGui::ColorEdit4("Color", glm::value_ptr(component.Color));
 
@@ -382,11 +481,10 @@ namespace Hazel
 				if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("CONTENT_BROWSER_ITEM"))
 				{
 					const FilePath path = (const wchar_t*)payload->Data;
-					auto texture = Texture2D::Create(path);
-					if (texture->IsLoaded())
-						component.Texture = texture;
-					else
-						HZ_WARN("Could not load texture {0}", path);
+					// The texture loads in the background, a file that can't be decoded is reported by the loader
+					const AssetHandle handle = AssetManager::ImportAsset(path, AssetType::Texture2D);
+					if (handle)
+						entity.PatchComponent<SpriteRendererComponent>([handle](SpriteRendererComponent& src) { src.Texture = handle; });
 				}
 				ImGui::EndDragDropTarget();
 			}
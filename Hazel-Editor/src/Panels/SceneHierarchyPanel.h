@@ -4,13 +4,22 @@
 #include "Hazel/Scene/Scene.h"
 #include "Hazel/Scene/Entity.h"
 
+#include <imgui/imgui.h>
+
 namespace Hazel
 {
+	// Only the rows in view are drawn. The row list is built once per context and then kept up to date
+	// through the registry's TagComponent signals, so the cost of a frame doesn't depend on the entity count.
 	class SceneHierarchyPanel
 	{
 	public:
 		SceneHierarchyPanel() = default;
 		SceneHierarchyPanel(const Ref<Scene>& context);
+		~SceneHierarchyPanel();
+
+		// The registry signals point back at the panel
+		SceneHierarchyPanel(const SceneHierarchyPanel&) = delete;
+		SceneHierarchyPanel& operator=(const SceneHierarchyPanel&) = delete;
 
 		void SetContext(const Ref<Scene>& context);
 
@@ -20,6 +29,13 @@ namespace Hazel
 		void SetSelectedEntity(Entity entity) { m_SelectionContext = entity; }
 
 	private:
+		void OnTagConstructed(entt::registry& registry, entt::entity entity);
+		void OnTagUpdated(entt::registry& registry, entt::entity entity);
+		void OnTagDestroyed(entt::registry& registry, entt::entity entity);
+
+		// Drops the rows of destroyed entities and applies the filter again, only if something changed
+		void UpdateRows();
+
 		void DrawEntityNode(Entity entity);
 		void DrawComponents(Entity entity);
 
@@ -29,5 +45,15 @@ namespace Hazel
 	private:
 		Ref<Scene> m_Context;
 		Entity m_SelectionContext;
+
+		// Every entity with a tag, destroyed ones leave an entt::null hole until the next UpdateRows
+		std::vector<EntityId> m_Rows;
+		std::unordered_map<EntityId, size_t> m_RowIndices;
+		bool m_HasHoles = false;
+
+		// The rows matching the filter, only used while it's active
+		ImGuiTextFilter m_Filter;
+		std::vector<EntityId> m_FilteredRows;
+		bool m_FilterDirty = false;
 	};
 }
@@ -6,11 +6,18 @@ namespace Hazel
     internal static class InternalCalls
     {
         [MethodImpl(MethodImplOptions.InternalCall)]
-        internal static extern bool Entity_HasComponent(ulong entityId, Type componentType);
+        internal static extern int Entity_GetComponentTypeId(Type componentType);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern bool Entity_HasComponent(ulong entityId, int componentTypeId);
 
         [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern ulong Entity_FindEntityByName(string name);
         [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern ulong[] Entity_FindEntitiesByName(string name);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern ulong[] Entity_FindEntitiesByNamePrefix(string prefix);
+        [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern object GetScriptInstance(ulong entityId);
 
 
@@ -7,6 +7,12 @@ namespace Hazel
         public Entity Entity { get; internal set; }
     }
 
+    // Resolved once per component type, the id is what Entity_HasComponent expects
+    internal static class ComponentType<T> where T : Component
+    {
+        internal static readonly int Id = InternalCalls.Entity_GetComponentTypeId(typeof(T));
+    }
+
     public class TransformComponent : Component
     {
         public Vector3 Position
@@ -7,6 +7,9 @@ namespace Hazel
     {
         public readonly ulong Id;
 
+        // Component wrappers indexed by component type id
+        private Component[] _components;
+
         protected Entity() { Id = 0; }
 
         internal Entity(ulong id)
@@ -28,16 +31,32 @@ namespace Hazel
 
         public bool HasComponent<T>() where T : Component, new()
         {
-            return InternalCalls.Entity_HasComponent(Id, typeof(T));
+            return InternalCalls.Entity_HasComponent(Id, ComponentType<T>.Id);
         }
 
         public T GetComponent<T>() where T : Component, new()
         {
-            if (!HasComponent<T>())
+            int typeId = ComponentType<T>.Id;
+            if (typeId < 0)
+                return null;
+
+            bool hasSlot = _components != null && typeId < _components.Length;
+            if (!InternalCalls.Entity_HasComponent(Id, typeId))
+            {
+                // The component was removed, drop the stale wrapper
+                if (hasSlot)
+                    _components[typeId] = null;
                 return null;
+            }
+
+            if (hasSlot && _components[typeId] is T cachedComponent)
+                return cachedComponent;
+
+            if (!hasSlot)
+                Array.Resize(ref _components, typeId + 1);
 
             T component = new T { Entity = this };
-            // TODO cache
+            _components[typeId] = component;
             return component;
         }
 
@@ -47,10 +66,28 @@ namespace Hazel
             return entityId == 0 ? null : new Entity(entityId);
         }
 
+        public Entity[] FindEntitiesByName(string name)
+        {
+            return ToEntities(InternalCalls.Entity_FindEntitiesByName(name));
+        }
+
+        public Entity[] FindEntitiesByNamePrefix(string prefix)
+        {
+            return ToEntities(InternalCalls.Entity_FindEntitiesByNamePrefix(prefix));
+        }
+
         public T As<T>() where T : Entity
         {
             object instance = InternalCalls.GetScriptInstance(Id);
             return instance as T;
         }
+
+        private static Entity[] ToEntities(ulong[] entityIds)
+        {
+            var entities = new Entity[entityIds.Length];
+            for (int i = 0; i < entityIds.Length; i++)
+                entities[i] = new Entity(entityIds[i]);
+            return entities;
+        }
     }
 }
\ No newline at end of file
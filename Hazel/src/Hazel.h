@@ -18,6 +18,8 @@
 
 #include "Hazel/ImGui/ImGuiLayer.h"
 
+#include "Hazel/Asset/AssetManager.h"
+
 #include "Hazel/Project/Project.h"
 
 #include "Hazel/Scene/Entity.h"
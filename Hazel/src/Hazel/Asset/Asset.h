@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Hazel/Core/UUID.h"
+
+namespace Hazel
+{
+	class Texture2D;
+	class Font;
+
+	// Handles are derived from the asset's path, so the same file always gets the same handle. 0 is the null handle
+	using AssetHandle = UUID;
+
+	enum class AssetType : uint16_t
+	{
+		None = 0,
+		Texture2D,
+		Font
+	};
+
+	template<typename T>
+	struct AssetTypeOf;
+
+	template<> struct AssetTypeOf<Texture2D> { static constexpr AssetType Type = AssetType::Texture2D; };
+	template<> struct AssetTypeOf<Font> { static constexpr AssetType Type = AssetType::Font; };
+}
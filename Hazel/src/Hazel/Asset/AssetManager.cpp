@@ -0,0 +1,208 @@
+#include "hzpch.h"
+#include "Hazel/Asset/AssetManager.h"
+
+#include "Hazel/Core/Hash.h"
+
+#include "Hazel/Renderer/Font.h"
+#include "Hazel/Renderer/Texture.h"
+
+namespace Hazel
+{
+	namespace Utils
+	{
+		static std::string GetAssetKey(const FilePath& path)
+		{
+			std::error_code error;
+			FilePath absolutePath = std::filesystem::absolute(path, error);
+			if (error)
+				absolutePath = path;
+
+			return absolutePath.lexically_normal().generic_string();
+		}
+
+		static AssetHandle GetAssetHandle(std::string_view key)
+		{
+			const uint64_t hash = Hash::FNV1a(key);
+			return hash != 0 ? hash : 1;
+		}
+
+		static const char* AssetTypeToString(AssetType type)
+		{
+			switch (type)
+			{
+				case AssetType::None:		return "None";
+				case AssetType::Texture2D:	return "Texture2D";
+				case AssetType::Font:		return "Font";
+			}
+
+			HZ_CORE_ASSERT(false, "Unknown asset type");
+			return "Unknown";
+		}
+	}
+
+	struct AssetMetadata
+	{
+		AssetType Type = AssetType::None;
+		FilePath Path;
+		uint32_t RefCount = 0;
+		Ref<void> Asset;
+	};
+
+	struct AssetManagerData
+	{
+		std::unordered_map<AssetHandle, AssetMetadata> Assets;
+		std::mutex Mutex;
+	};
+
+	static AssetManagerData* s_Data = nullptr;
+
+	void AssetManager::Init()
+	{
+		HZ_CORE_ASSERT(!s_Data, "AssetManager already initialized");
+		s_Data = new AssetManagerData();
+	}
+
+	void AssetManager::Shutdown()
+	{
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	AssetHandle AssetManager::ImportAsset(const FilePath& path, AssetType type)
+	{
+		if (path.empty())
+			return 0;
+
+		const AssetHandle handle = Utils::GetAssetHandle(Utils::GetAssetKey(path));
+
+		std::scoped_lock lock(s_Data->Mutex);
+		const auto [it, inserted] = s_Data->Assets.try_emplace(handle);
+		if (inserted)
+		{
+			it->second.Type = type;
+			it->second.Path = path;
+		}
+		else if (it->second.Type != type)
+		{
+			HZ_CORE_ERROR("Asset {0} was imported as {1} and as {2}", path, Utils::AssetTypeToString(it->second.Type), Utils::AssetTypeToString(type));
+			return 0;
+		}
+
+		return handle;
+	}
+
+	void AssetManager::Acquire(AssetHandle handle)
+	{
+		if (handle == 0)
+			return;
+
+		std::scoped_lock lock(s_Data->Mutex);
+		if (const auto it = s_Data->Assets.find(handle); it != s_Data->Assets.end())
+			it->second.RefCount++;
+	}
+
+	void AssetManager::Release(AssetHandle handle)
+	{
+		// Scenes can outlive the manager on shutdown
+		if (handle == 0 || !s_Data)
+			return;
+
+		std::scoped_lock lock(s_Data->Mutex);
+		if (const auto it = s_Data->Assets.find(handle); it != s_Data->Assets.end())
+		{
+			HZ_CORE_ASSERT(it->second.RefCount > 0, "Asset released more times than it was acquired");
+			it->second.RefCount--;
+		}
+	}
+
+	Ref<void> AssetManager::GetAsset(AssetHandle handle, AssetType type)
+	{
+		if (handle == 0)
+			return nullptr;
+
+		std::scoped_lock lock(s_Data->Mutex);
+		const auto it = s_Data->Assets.find(handle);
+		if (it == s_Data->Assets.end())
+			return nullptr;
+
+		AssetMetadata& metadata = it->second;
+		if (metadata.Type != type)
+		{
+			HZ_CORE_ERROR("Asset {0} is a {1}, not a {2}", metadata.Path, Utils::AssetTypeToString(metadata.Type), Utils::AssetTypeToString(type));
+			return nullptr;
+		}
+
+		if (!metadata.Asset)
+		{
+			HZ_PROFILE_SCOPE("AssetManager::LoadAsset");
+
+			switch (metadata.Type)
+			{
+				case AssetType::Texture2D:
+					metadata.Asset = Texture2D::CreateAsync(metadata.Path);
+					break;
+				case AssetType::Font:
+					metadata.Asset = Font::CreateAsync(metadata.Path);
+					break;
+				case AssetType::None:
+					break;
+			}
+		}
+
+		return metadata.Asset;
+	}
+
+	bool AssetManager::IsAssetHandleValid(AssetHandle handle)
+	{
+		std::scoped_lock lock(s_Data->Mutex);
+		return s_Data->Assets.find(handle) != s_Data->Assets.end();
+	}
+
+	bool AssetManager::IsAssetLoaded(AssetHandle handle)
+	{
+		std::scoped_lock lock(s_Data->Mutex);
+		const auto it = s_Data->Assets.find(handle);
+		return it != s_Data->Assets.end() && it->second.Asset;
+	}
+
+	AssetType AssetManager::GetAssetType(AssetHandle handle)
+	{
+		std::scoped_lock lock(s_Data->Mutex);
+		const auto it = s_Data->Assets.find(handle);
+		return it != s_Data->Assets.end() ? it->second.Type : AssetType::None;
+	}
+
+	FilePath AssetManager::GetAssetPath(AssetHandle handle)
+	{
+		std::scoped_lock lock(s_Data->Mutex);
+		const auto it = s_Data->Assets.find(handle);
+		return it != s_Data->Assets.end() ? it->second.Path : FilePath();
+	}
+
+	uint32_t AssetManager::GetReferenceCount(AssetHandle handle)
+	{
+		std::scoped_lock lock(s_Data->Mutex);
+		const auto it = s_Data->Assets.find(handle);
+		return it != s_Data->Assets.end() ? it->second.RefCount : 0;
+	}
+
+	uint32_t AssetManager::EvictUnusedAssets()
+	{
+		std::scoped_lock lock(s_Data->Mutex);
+
+		uint32_t evicted = 0;
+		for (auto& [handle, metadata] : s_Data->Assets)
+		{
+			if (metadata.RefCount == 0 && metadata.Asset)
+			{
+				metadata.Asset = nullptr;
+				evicted++;
+			}
+		}
+
+		if (evicted > 0)
+			HZ_CORE_TRACE("Evicted {0} unused assets", evicted);
+
+		return evicted;
+	}
+}
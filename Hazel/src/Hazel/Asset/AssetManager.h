@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Hazel/Asset/Asset.h"
+#include "Hazel/Core/Base.h"
+#include "Hazel/Core/FileSystem.h"
+
+namespace Hazel
+{
+	// Registry of every asset referenced by the engine, each file is loaded once no matter how many users it has.
+	// Importing only registers the path, the asset is loaded the first time it's requested.
+	// Users that hold on to a handle (scene components) Acquire/Release it, assets nobody references
+	// stay cached until EvictUnusedAssets is called so reloading a scene doesn't load them again.
+	class AssetManager
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		// Thread safe
+		static AssetHandle ImportAsset(const FilePath& path, AssetType type);
+		static void Acquire(AssetHandle handle);
+		static void Release(AssetHandle handle);
+
+		// Loads the asset if needed, so it must be called from the main thread. Returns nullptr if the handle is unknown
+		template<typename T>
+		static Ref<T> GetAsset(AssetHandle handle)
+		{
+			return std::static_pointer_cast<T>(GetAsset(handle, AssetTypeOf<T>::Type));
+		}
+
+		static bool IsAssetHandleValid(AssetHandle handle);
+		static bool IsAssetLoaded(AssetHandle handle);
+		static AssetType GetAssetType(AssetHandle handle);
+		// Path the asset was first imported with
+		static FilePath GetAssetPath(AssetHandle handle);
+		static uint32_t GetReferenceCount(AssetHandle handle);
+
+		// Unloads every asset with no references left, returns how many were unloaded
+		static uint32_t EvictUnusedAssets();
+	private:
+		static Ref<void> GetAsset(AssetHandle handle, AssetType type);
+	};
+}
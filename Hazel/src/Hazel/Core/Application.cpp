@@ -1,7 +1,10 @@
 #include "hzpch.h"
 #include "Hazel/Core/Application.h"
 
+#include "Hazel/Asset/AssetManager.h"
+#include "Hazel/Renderer/Font.h"
 #include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/TextureLoader.h"
 
 #include <GLFW/glfw3.h>
 
@@ -25,8 +28,12 @@ namespace Hazel
 		m_Window->SetEventCallback(HZ_BIND_EVENT_FN(Application::OnEvent));
 		m_Window->SetVSync(false);
 
-		Renderer::Init();
+		Renderer::Init(m_Specification.RendererConfig);
+		AssetManager::Init();
 		ScriptEngine::Init();
+
+		// Default constructed TextComponents use it, and scenes may be deserialized on other threads
+		Font::GetDefault();
 		
 		m_ImGuiLayer = new ImGuiLayer();
 		PushOverlay(m_ImGuiLayer);
@@ -37,6 +44,7 @@ namespace Hazel
 		HZ_PROFILE_FUNCTION();
 
 		ScriptEngine::Shutdown();
+		AssetManager::Shutdown();
 		Renderer::Shutdown();
 	}
 
@@ -59,6 +67,7 @@ namespace Hazel
 			m_LastFrameTime = time;
 
 			ExecuteMainThreadQueue();
+			TextureLoader::ProcessUploads();
 
 			if (!m_Minimized)
 			{
@@ -144,11 +153,14 @@ namespace Hazel
 
 	void Application::ExecuteMainThreadQueue()
 	{
-		std::scoped_lock lock(m_MainThreadQueueMutex);
+		// Swap the queue out so queued functions can submit more work, which runs on the next frame
+		std::vector<std::function<void()>> queue;
+		{
+			std::scoped_lock lock(m_MainThreadQueueMutex);
+			queue.swap(m_MainThreadQueue);
+		}
 
-		for (auto& func : m_MainThreadQueue)
+		for (auto& func : queue)
 			func();
-
-		m_MainThreadQueue.clear();
 	}
 }
@@ -6,6 +6,7 @@
 #include "Hazel/Events/ApplicationEvent.h"
 #include "Hazel/Events/Event.h"
 #include "Hazel/ImGui/ImGuiLayer.h"
+#include "Hazel/Renderer/Renderer.h"
 #include "Hazel/Scripting/ScriptEngine.h"
 
 int main(int argc, char** argv);
@@ -29,6 +30,7 @@ namespace Hazel
 		std::string Name = "Hazel Application";
 		std::string WorkingDirectory;
 		ScriptEngineConfig ScriptEngineConfig;
+		RendererConfig RendererConfig;
 		ApplicationCommandLineArgs CommandLineArgs;
 	};
 
@@ -13,4 +13,30 @@ namespace Hazel
 	public:
 		static Buffer ReadFileBinary(const FilePath& filepath);
 	};
+
+	// Read-only view of a whole file mapped into memory, unmapped when destroyed
+	class MappedFile
+	{
+	public:
+		MappedFile(const FilePath& filepath);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		const uint8_t* Data() const { return m_Data; }
+		uint64_t Size() const { return m_Size; }
+
+		template<typename T>
+		const T* As() const { return (const T*)m_Data; }
+
+		operator bool() const { return m_Data; }
+
+	private:
+		const uint8_t* m_Data = nullptr;
+		uint64_t m_Size = 0;
+
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
+	};
 }
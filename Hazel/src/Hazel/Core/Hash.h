@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Hazel
+{
+	namespace Hash
+	{
+		constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+		constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+		// FNV-1a, pass a previous result as the seed to hash several blocks as one
+		inline uint64_t FNV1a(const void* data, uint64_t size, uint64_t seed = FNV_OFFSET_BASIS)
+		{
+			const auto* bytes = (const uint8_t*)data;
+			uint64_t hash = seed;
+			for (uint64_t i = 0; i < size; i++)
+			{
+				hash ^= bytes[i];
+				hash *= FNV_PRIME;
+			}
+			return hash;
+		}
+
+		inline uint64_t FNV1a(std::string_view string, uint64_t seed = FNV_OFFSET_BASIS)
+		{
+			return FNV1a(string.data(), string.size(), seed);
+		}
+	}
+}
@@ -0,0 +1,70 @@
+#include "hzpch.h"
+#include "Hazel/Core/ThreadPool.h"
+
+namespace Hazel
+{
+	ThreadPool::ThreadPool(uint32_t threadCount)
+	{
+		if (threadCount == 0)
+			threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		m_Threads.reserve(threadCount);
+		for (uint32_t i = 0; i < threadCount; i++)
+			m_Threads.emplace_back([this] { WorkerLoop(); });
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::scoped_lock lock(m_Mutex);
+			m_Stopping = true;
+			m_Jobs.clear();
+		}
+
+		m_JobAvailable.notify_all();
+		for (auto& thread : m_Threads)
+			thread.join();
+	}
+
+	void ThreadPool::Submit(std::function<void()> job)
+	{
+		{
+			std::scoped_lock lock(m_Mutex);
+			m_Jobs.push_back(std::move(job));
+		}
+
+		m_JobAvailable.notify_one();
+	}
+
+	void ThreadPool::Wait()
+	{
+		std::unique_lock lock(m_Mutex);
+		m_JobsFinished.wait(lock, [this] { return m_Jobs.empty() && m_RunningJobs == 0; });
+	}
+
+	void ThreadPool::WorkerLoop()
+	{
+		while (true)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock lock(m_Mutex);
+				m_JobAvailable.wait(lock, [this] { return m_Stopping || !m_Jobs.empty(); });
+				if (m_Stopping)
+					return;
+
+				job = std::move(m_Jobs.front());
+				m_Jobs.pop_front();
+				m_RunningJobs++;
+			}
+
+			job();
+
+			{
+				std::scoped_lock lock(m_Mutex);
+				m_RunningJobs--;
+			}
+			m_JobsFinished.notify_all();
+		}
+	}
+}
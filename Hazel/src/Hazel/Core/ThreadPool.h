@@ -0,0 +1,42 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Hazel
+{
+	// Fixed set of worker threads running jobs in submission order.
+	// Jobs still queued when the pool is destroyed are discarded, the ones already running are waited for.
+	class ThreadPool
+	{
+	public:
+		// 0 uses one thread per hardware thread minus the main thread
+		explicit ThreadPool(uint32_t threadCount = 0);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		void Submit(std::function<void()> job);
+
+		// Blocks until every submitted job has finished
+		void Wait();
+
+		uint32_t GetThreadCount() const { return (uint32_t)m_Threads.size(); }
+	private:
+		void WorkerLoop();
+	private:
+		std::vector<std::thread> m_Threads;
+		std::deque<std::function<void()>> m_Jobs;
+		uint32_t m_RunningJobs = 0;
+		bool m_Stopping = false;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_JobAvailable;
+		std::condition_variable m_JobsFinished;
+	};
+}
@@ -6,8 +6,17 @@
 #include "FontGeometry.h"
 #include "GlyphGeometry.h"
 
+#include "Hazel/Asset/AssetManager.h"
+#include "Hazel/Core/Application.h"
+#include "Hazel/Core/Hash.h"
+#include "Hazel/Core/ThreadPool.h"
+#include "Hazel/Core/Timer.h"
 #include "Hazel/Renderer/MSDFData.h"
 
+#include <atomic>
+#include <fstream>
+#include <thread>
+
 namespace Hazel
 {
 	struct CharsetRange
@@ -15,8 +24,325 @@ namespace Hazel
 		uint32_t Begin, End;
 	};
 
+	// From imgui_draw.cpp
+	static constexpr CharsetRange s_CharsetRanges[] =
+	{
+		{ 0x0020, 0x00FF } // Basic Latin + Latin Supplement
+	};
+
+	static constexpr double s_EmSize = 40.0;
+	static constexpr double s_PixelRange = 2.0;
+	static constexpr double s_MiterLimit = 1.0;
+	static constexpr double s_AngleThreshold = 3.0;
+
+	// Dynamic pages are RGB8, the padding keeps the bilinear filter from bleeding neighbours into a glyph
+	static constexpr uint32_t s_DynamicPageSize = 1024;
+	static constexpr uint32_t s_DynamicPagePadding = 1;
+
+	constexpr uint32_t FONT_CACHE_MAGIC = 'H' | ('Z' << 8) | ('F' << 16) | ('N' << 24);
+	// Bump when the layout changes or when the atlas is generated differently
+	constexpr uint32_t FONT_CACHE_VERSION = 1;
+
+	// Followed by the glyphs, the kerning pairs and the RGB8 atlas pixels
+	struct FontCacheHeader
+	{
+		uint32_t Magic = FONT_CACHE_MAGIC;
+		uint32_t Version = FONT_CACHE_VERSION;
+		uint64_t Key = 0;
+		uint32_t AtlasWidth = 0;
+		uint32_t AtlasHeight = 0;
+		uint32_t GlyphCount = 0;
+		uint32_t KerningCount = 0;
+		MSDFMetrics Metrics;
+	};
+
+	struct FontCacheKerning
+	{
+		uint32_t First, Second;
+		double Advance;
+	};
+
+	// Loads glyphs for on demand generation. Shared between a font and its pending jobs so a font
+	// can be destroyed while its glyphs are still being generated.
+	struct FontGlyphSource
+	{
+		FilePath Path;
+
+		// FreeType faces aren't thread safe, only loading the outline happens under the lock
+		std::mutex Mutex;
+		bool Opened = false;
+		msdfgen::FreetypeHandle* Freetype = nullptr;
+		msdfgen::FontHandle* Handle = nullptr;
+		// Scales the outlines so 1 is the em size, the same as the preloaded charset
+		double GeometryScale = 1.0;
+
+		~FontGlyphSource()
+		{
+			if (Handle)
+				msdfgen::destroyFont(Handle);
+			if (Freetype)
+				msdfgen::deinitializeFreetype(Freetype);
+		}
+	};
+
+	// Output of a glyph job, atlas bounds are relative to the glyph's own bitmap
+	struct GeneratedGlyph
+	{
+		MSDFGlyph Glyph;
+		bool Found = false;
+		uint32_t Width = 0, Height = 0;
+		std::vector<uint8_t> Pixels;
+	};
+
+	// Everything loading a font produces before its atlas is uploaded
+	struct FontAtlasData
+	{
+		MSDFData Layout;
+		uint32_t Width = 0, Height = 0;
+		// RGB8
+		std::vector<uint8_t> Pixels;
+	};
+
+	// Loads fonts and generates glyphs on demand
+	static Scope<ThreadPool> s_Workers;
+
+	namespace Utils
+	{
+		static FilePath GetFontCacheDirectory()
+		{
+			return "assets/cache/font";
+		}
+
+		static FilePath GetFontCachePath(uint64_t key)
+		{
+			return GetFontCacheDirectory() / fmt::format("{:016x}.hzfont", key);
+		}
+
+		// Covers everything the atlas is generated from, so an entry is never stale
+		static uint64_t GetFontCacheKey(const MappedFile& fontFile)
+		{
+			uint64_t key = Hash::FNV1a(fontFile.Data(), fontFile.Size());
+			key = Hash::FNV1a(s_CharsetRanges, sizeof(s_CharsetRanges), key);
+			key = Hash::FNV1a(&s_EmSize, sizeof(s_EmSize), key);
+			key = Hash::FNV1a(&s_PixelRange, sizeof(s_PixelRange), key);
+			key = Hash::FNV1a(&s_MiterLimit, sizeof(s_MiterLimit), key);
+			return key;
+		}
+
+		static Ref<Texture2D> CreateAtlasTexture(uint32_t width, uint32_t height, const void* pixels)
+		{
+			TextureSpecification spec;
+			spec.Width = width;
+			spec.Height = height;
+			spec.Format = ImageFormat::RGB8;
+			spec.GenerateMips = false;
+
+			Ref<Texture2D> texture = Texture2D::Create(spec);
+			texture->SetData((void*)pixels, width * height * 3);
+			return texture;
+		}
+
+		static bool LoadAtlasFromCache(uint64_t key, FontAtlasData& outAtlas)
+		{
+			const MappedFile file(GetFontCachePath(key));
+			if (!file || file.Size() < sizeof(FontCacheHeader))
+				return false;
+
+			const auto* header = file.As<FontCacheHeader>();
+			if (header->Magic != FONT_CACHE_MAGIC || header->Version != FONT_CACHE_VERSION || header->Key != key)
+				return false;
+
+			const uint64_t glyphsSize = (uint64_t)header->GlyphCount * sizeof(MSDFGlyph);
+			const uint64_t kerningSize = (uint64_t)header->KerningCount * sizeof(FontCacheKerning);
+			const uint64_t pixelsSize = (uint64_t)header->AtlasWidth * header->AtlasHeight * 3;
+			if (sizeof(FontCacheHeader) + glyphsSize + kerningSize + pixelsSize != file.Size())
+				return false;
+
+			const uint8_t* data = file.Data() + sizeof(FontCacheHeader);
+
+			MSDFData& outData = outAtlas.Layout;
+			outData.Metrics = header->Metrics;
+
+			const auto* glyphs = (const MSDFGlyph*)data;
+			for (uint32_t i = 0; i < header->GlyphCount; i++)
+				outData.Glyphs.emplace(glyphs[i].Codepoint, glyphs[i]);
+			data += glyphsSize;
+
+			const auto* kerning = (const FontCacheKerning*)data;
+			for (uint32_t i = 0; i < header->KerningCount; i++)
+				outData.Kerning.emplace(std::make_pair(kerning[i].First, kerning[i].Second), kerning[i].Advance);
+			data += kerningSize;
+
+			outAtlas.Width = header->AtlasWidth;
+			outAtlas.Height = header->AtlasHeight;
+			outAtlas.Pixels.assign(data, data + pixelsSize);
+			return true;
+		}
+
+		static void StoreAtlasInCache(uint64_t key, const MSDFData& data, uint32_t width, uint32_t height, const void* pixels)
+		{
+			FontCacheHeader header;
+			header.Key = key;
+			header.AtlasWidth = width;
+			header.AtlasHeight = height;
+			header.GlyphCount = (uint32_t)data.Glyphs.size();
+			header.KerningCount = (uint32_t)data.Kerning.size();
+			header.Metrics = data.Metrics;
+
+			std::error_code error;
+			std::filesystem::create_directories(GetFontCacheDirectory(), error);
+
+			// Written under a temporary name first so a reader never maps a half written entry
+			const FilePath cachePath = GetFontCachePath(key);
+			FilePath tempPath = cachePath;
+			tempPath += fmt::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+			{
+				std::ofstream out(tempPath, std::ios::out | std::ios::binary);
+				if (!out)
+				{
+					HZ_CORE_WARN("Could not write font cache entry {0}", cachePath);
+					return;
+				}
+
+				out.write((const char*)&header, sizeof(FontCacheHeader));
+				for (const auto& [codepoint, glyph] : data.Glyphs)
+					out.write((const char*)&glyph, sizeof(MSDFGlyph));
+				for (const auto& [pair, advance] : data.Kerning)
+				{
+					const FontCacheKerning kerning = { pair.first, pair.second, advance };
+					out.write((const char*)&kerning, sizeof(FontCacheKerning));
+				}
+				out.write((const char*)pixels, (std::streamsize)width * height * 3);
+			}
+
+			std::filesystem::rename(tempPath, cachePath, error);
+			if (error)
+				std::filesystem::remove(tempPath, error);
+		}
+
+		// Copies what the renderer needs out of the msdf-atlas-gen geometry
+		static void ExtractGlyphLayout(const msdf_atlas::FontGeometry& fontGeometry, const std::vector<msdf_atlas::GlyphGeometry>& glyphs, MSDFData& outData)
+		{
+			const msdfgen::FontMetrics& metrics = fontGeometry.getMetrics();
+			outData.Metrics.EmSize = metrics.emSize;
+			outData.Metrics.AscenderY = metrics.ascenderY;
+			outData.Metrics.DescenderY = metrics.descenderY;
+			outData.Metrics.LineHeight = metrics.lineHeight;
+			outData.Metrics.UnderlineY = metrics.underlineY;
+			outData.Metrics.UnderlineThickness = metrics.underlineThickness;
+
+			for (const msdf_atlas::GlyphGeometry& geometry : glyphs)
+			{
+				MSDFGlyph glyph;
+				glyph.Codepoint = geometry.getCodepoint();
+				glyph.Advance = geometry.getAdvance();
+				geometry.getQuadPlaneBounds(glyph.PlaneBounds[0], glyph.PlaneBounds[1], glyph.PlaneBounds[2], glyph.PlaneBounds[3]);
+				geometry.getQuadAtlasBounds(glyph.AtlasBounds[0], glyph.AtlasBounds[1], glyph.AtlasBounds[2], glyph.AtlasBounds[3]);
+				outData.Glyphs.emplace(glyph.Codepoint, glyph);
+			}
+
+			// Kerning is stored per glyph index pair in FontGeometry, asking for every pair keeps this independent of that
+			for (const auto& [first, firstGlyph] : outData.Glyphs)
+			{
+				for (const auto& [second, secondGlyph] : outData.Glyphs)
+				{
+					double advance;
+					if (fontGeometry.getAdvance(advance, first, second) && advance != firstGlyph.Advance)
+						outData.Kerning.emplace(std::make_pair(first, second), advance - firstGlyph.Advance);
+				}
+			}
+		}
+
+		// Worker thread
+		static GeneratedGlyph GenerateGlyph(FontGlyphSource& source, uint32_t codepoint)
+		{
+			HZ_PROFILE_FUNCTION();
+
+			GeneratedGlyph generated;
+			generated.Glyph.Codepoint = codepoint;
+
+			msdf_atlas::GlyphGeometry geometry;
+			{
+				std::scoped_lock lock(source.Mutex);
+
+				if (!source.Opened)
+				{
+					source.Opened = true;
+					source.Freetype = msdfgen::initializeFreetype();
+					if (source.Freetype)
+						source.Handle = msdfgen::loadFont(source.Freetype, source.Path.string().c_str());
+
+					msdfgen::FontMetrics metrics;
+					if (source.Handle && msdfgen::getFontMetrics(metrics, source.Handle) && metrics.emSize > 0.0)
+						source.GeometryScale = 1.0 / metrics.emSize;
+				}
+
+				// FreeType falls back to the .notdef glyph, that one should show up as '?' instead
+				msdfgen::GlyphIndex glyphIndex;
+				if (!source.Handle || !msdfgen::getGlyphIndex(glyphIndex, source.Handle, codepoint))
+					return generated;
+
+				if (!geometry.load(source.Handle, source.GeometryScale, codepoint))
+					return generated;
+			}
+
+			generated.Found = true;
+
+			// Same settings the tight atlas packer uses for the preloaded charset
+			geometry.edgeColoring(msdfgen::edgeColoringInkTrap, s_AngleThreshold, 0);
+			geometry.wrapBox(s_EmSize, s_PixelRange / s_EmSize, s_MiterLimit);
+			geometry.placeBox(0, 0);
+
+			generated.Glyph.Advance = geometry.getAdvance();
+			geometry.getQuadPlaneBounds(generated.Glyph.PlaneBounds[0], generated.Glyph.PlaneBounds[1], generated.Glyph.PlaneBounds[2], generated.Glyph.PlaneBounds[3]);
+			geometry.getQuadAtlasBounds(generated.Glyph.AtlasBounds[0], generated.Glyph.AtlasBounds[1], generated.Glyph.AtlasBounds[2], generated.Glyph.AtlasBounds[3]);
+
+			int width, height;
+			geometry.getBoxSize(width, height);
+			if (geometry.isWhitespace() || width <= 0 || height <= 0)
+				return generated;
+
+			msdf_atlas::GeneratorAttributes attributes;
+			attributes.config.overlapSupport = true;
+			attributes.scanlinePass = true;
+
+			std::vector<float> distances((size_t)width * height * 3);
+			msdf_atlas::msdfGenerator(msdfgen::BitmapRef<float, 3>(distances.data(), width, height), geometry, attributes);
+
+			generated.Width = (uint32_t)width;
+			generated.Height = (uint32_t)height;
+			generated.Pixels.resize(distances.size());
+			for (size_t i = 0; i < distances.size(); i++)
+				generated.Pixels[i] = msdfgen::pixelFloatToByte(distances[i]);
+
+			return generated;
+		}
+	}
+
+	// Atlases being generated right now, they share the hardware threads between them
+	static std::atomic<uint32_t> s_ActiveAtlasGenerations = 0;
+
+	// Counts an atlas generation for as long as it's alive
+	struct AtlasGenerationScope
+	{
+		AtlasGenerationScope() { s_ActiveAtlasGenerations++; }
+		~AtlasGenerationScope() { s_ActiveAtlasGenerations--; }
+
+		AtlasGenerationScope(const AtlasGenerationScope&) = delete;
+		AtlasGenerationScope& operator=(const AtlasGenerationScope&) = delete;
+	};
+
+	// msdf-atlas-gen runs its own threads while the worker that started the generation only waits for them,
+	// so a generation gets its share of the hardware threads instead of stacking on top of the other loads
+	static int GetGeneratorThreadCount()
+	{
+		const uint32_t activeGenerations = std::max(s_ActiveAtlasGenerations.load(), 1u);
+		return (int)std::max(std::thread::hardware_concurrency() / activeGenerations, 1u);
+	}
+
 	template<typename T, typename S, int N, msdf_atlas::GeneratorFunction<S, N> GenFunc>
-	static Ref<Texture2D> CreateAndCacheAtlas(const std::string& fontName, float fontSize, const MSDFData* data, uint32_t width, uint32_t height)
+	static void GenerateAndCacheAtlas(uint64_t cacheKey, const std::vector<msdf_atlas::GlyphGeometry>& glyphs, uint32_t width, uint32_t height, int threadCount, FontAtlasData& outAtlas)
 	{
 		msdf_atlas::GeneratorAttributes attributes;
 		attributes.config.overlapSupport = true;
@@ -24,25 +350,45 @@ namespace Hazel
 
 		msdf_atlas::ImmediateAtlasGenerator<S, N, GenFunc, msdf_atlas::BitmapAtlasStorage<T, N>> generator(width, height);
 		generator.setAttributes(attributes);
-		generator.setThreadCount(8);
-		generator.generate(data->Glyphs.data(), (int)data->Glyphs.size());
+		generator.setThreadCount(threadCount);
+		generator.generate(glyphs.data(), (int)glyphs.size());
 
 		auto bitmap = (msdfgen::BitmapConstRef<T, N>)generator.atlasStorage();
 
-		TextureSpecification spec;
-		spec.Width = bitmap.width;
-		spec.Height = bitmap.height;
-		spec.Format = ImageFormat::RGB8;
-		spec.GenerateMips = false;
+		Utils::StoreAtlasInCache(cacheKey, outAtlas.Layout, bitmap.width, bitmap.height, bitmap.pixels);
 
-		Ref<Texture2D> texture = Texture2D::Create(spec);
-		texture->SetData((void*)bitmap.pixels, bitmap.width * bitmap.height * 3);
-		return texture;
+		outAtlas.Width = (uint32_t)bitmap.width;
+		outAtlas.Height = (uint32_t)bitmap.height;
+		outAtlas.Pixels.assign((const uint8_t*)bitmap.pixels, (const uint8_t*)bitmap.pixels + (size_t)bitmap.width * bitmap.height * N);
 	}
 
-	Font::Font(const FilePath& fontPath)
-		: m_Data(new MSDFData)
+	// Doesn't touch the renderer, so it can run on any thread
+	static bool LoadFontAtlas(const FilePath& fontPath, FontAtlasData& outAtlas)
 	{
+		HZ_PROFILE_FUNCTION();
+
+		Timer timer;
+
+		uint64_t cacheKey;
+		{
+			const MappedFile fontFile(fontPath);
+			if (!fontFile)
+			{
+				HZ_CORE_ERROR("Failed to load font: {}", fontPath);
+				return false;
+			}
+
+			cacheKey = Utils::GetFontCacheKey(fontFile);
+		}
+
+		if (Utils::LoadAtlasFromCache(cacheKey, outAtlas))
+		{
+			HZ_CORE_TRACE("Loaded font atlas for {0} from cache in {1:.2f} ms", fontPath, timer.ElapsedMillis());
+			return true;
+		}
+
+		AtlasGenerationScope generationScope;
+
 		msdfgen::FreetypeHandle* ft = msdfgen::initializeFreetype();
 		HZ_CORE_ASSERT(ft);
 			
@@ -50,70 +396,123 @@ namespace Hazel
 		if (!font)
 		{
 			HZ_CORE_ERROR("Failed to load font: {}", fontPath);
-			return;
+			msdfgen::deinitializeFreetype(ft);
+			return false;
 		}
 
-		// From imgui_draw.cpp
-		static constexpr CharsetRange charsetRanges[] = 
-		{
-			{ 0x0020, 0x00FF } // Basic Latin + Latin Supplement
-		};
-
 		msdf_atlas::Charset charset;
-		for (const CharsetRange range: charsetRanges)
+		for (const CharsetRange range : s_CharsetRanges)
 			for (uint32_t c = range.Begin; c <= range.End; c++)
 				charset.add(c);
 
+		// Only needed while generating, the renderer reads the layout copied into the atlas data
+		std::vector<msdf_atlas::GlyphGeometry> glyphs;
+
 		constexpr double fontScale = 1.0;
-		m_Data->FontGeometry = msdf_atlas::FontGeometry(&m_Data->Glyphs);
-		int glyphsLoaded = m_Data->FontGeometry.loadCharset(font, fontScale, charset);
+		msdf_atlas::FontGeometry fontGeometry(&glyphs);
+		int glyphsLoaded = fontGeometry.loadCharset(font, fontScale, charset);
 		HZ_CORE_INFO("Loaded {} glyphs from font (out of {})", glyphsLoaded, charset.size());
 
-		double emSize = 40.0;
+		double emSize = s_EmSize;
 		msdf_atlas::TightAtlasPacker atlasPacker;
-		atlasPacker.setPixelRange(2.0); 
-		atlasPacker.setMiterLimit(1.0);
+		atlasPacker.setPixelRange(s_PixelRange); 
+		atlasPacker.setMiterLimit(s_MiterLimit);
 		atlasPacker.setPadding(0);
 		atlasPacker.setScale(emSize);
-		int remaining = atlasPacker.pack(m_Data->Glyphs.data(), (int)m_Data->Glyphs.size());
+		int remaining = atlasPacker.pack(glyphs.data(), (int)glyphs.size());
 		HZ_CORE_ASSERT(remaining == 0);
 
 		int width, height;
 		atlasPacker.getDimensions(width, height);
 		emSize = atlasPacker.getScale();
 
+		// Taken once, loads starting or finishing meanwhile adjust their own share
+		const int threadCount = GetGeneratorThreadCount();
+
 		// if MSDF || MTSDF
 		// From msdf-atlas-gen/main.cpp
 
-#define DEFAULT_ANGLE_THRESHOLD 3.0
 #define LCG_MULTIPLIER 6364136223846793005ull
 #define LCG_INCREMENT 1442695040888963407ull
-#define THREAD_COUNT 8
 
 		uint64_t coloringSeed = 0;
 		const bool expensiveColoring = true;
 		if (expensiveColoring) 
 		{
-			msdf_atlas::Workload([&glyphs = m_Data->Glyphs, &coloringSeed](int i, int threadNo) -> bool {
+			msdf_atlas::Workload([&glyphs, &coloringSeed](int i, int threadNo) -> bool {
 				unsigned long long glyphSeed = (LCG_MULTIPLIER * (coloringSeed ^ i) + LCG_INCREMENT) * !!coloringSeed;
-				glyphs[i].edgeColoring(msdfgen::edgeColoringInkTrap, DEFAULT_ANGLE_THRESHOLD, glyphSeed);
+				glyphs[i].edgeColoring(msdfgen::edgeColoringInkTrap, s_AngleThreshold, glyphSeed);
 				return true;
-			}, m_Data->Glyphs.size()).finish(THREAD_COUNT);
+			}, (int)glyphs.size()).finish(threadCount);
 		}
 		else 
 		{
 			unsigned long long glyphSeed = coloringSeed;
-			for (msdf_atlas::GlyphGeometry& glyph : m_Data->Glyphs) 
+			for (msdf_atlas::GlyphGeometry& glyph : glyphs) 
 			{
 				glyphSeed *= LCG_MULTIPLIER;
-				glyph.edgeColoring(msdfgen::edgeColoringInkTrap, DEFAULT_ANGLE_THRESHOLD, glyphSeed);
+				glyph.edgeColoring(msdfgen::edgeColoringInkTrap, s_AngleThreshold, glyphSeed);
 			}
 		}
 
-		m_AtlasTexture = CreateAndCacheAtlas<uint8_t, float, 3, msdf_atlas::msdfGenerator>("Test", (float)emSize, m_Data, width, height);
+		Utils::ExtractGlyphLayout(fontGeometry, glyphs, outAtlas.Layout);
+		GenerateAndCacheAtlas<uint8_t, float, 3, msdf_atlas::msdfGenerator>(cacheKey, glyphs, width, height, threadCount, outAtlas);
 
 		msdfgen::destroyFont(font);
 		msdfgen::deinitializeFreetype(ft);
+
+		HZ_CORE_TRACE("Generated font atlas for {0} in {1:.2f} ms ({2} threads)", fontPath, timer.ElapsedMillis(), threadCount);
+		return true;
+	}
+
+	Ref<Font> Font::CreateAsync(const FilePath& fontPath)
+	{
+		Ref<Font> font = CreateRef<Font>(fontPath, true);
+
+		// Only a weak reference is kept, fonts dropped while loading are skipped
+		s_Workers->Submit([weakFont = std::weak_ptr<Font>(font), fontPath]
+		{
+			if (weakFont.expired())
+				return;
+
+			auto atlas = CreateRef<FontAtlasData>();
+			if (!LoadFontAtlas(fontPath, *atlas))
+				return;
+
+			Application::Get().SubmitToMainThread([weakFont, atlas]
+			{
+				if (auto font = weakFont.lock())
+					font->UploadAtlas(*atlas);
+			});
+		});
+
+		return font;
+	}
+
+	Font::Font(const FilePath& fontPath, bool loadAsync)
+		: m_Data(new MSDFData)
+	{
+		m_GlyphSource = CreateRef<FontGlyphSource>();
+		m_GlyphSource->Path = fontPath;
+
+		if (loadAsync)
+			return;
+
+		FontAtlasData atlas;
+		if (LoadFontAtlas(fontPath, atlas))
+			UploadAtlas(atlas);
+	}
+
+	void Font::UploadAtlas(FontAtlasData& atlas)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		*m_Data = std::move(atlas.Layout);
+		m_AtlasPages.push_back({ Utils::CreateAtlasTexture(atlas.Width, atlas.Height, atlas.Pixels.data()) });
+		BuildGlyphTables();
+
+		// Layouts built while the font was loading are empty
+		m_Generation++;
 	}
 
 	Font::~Font()
@@ -121,11 +520,199 @@ namespace Hazel
 		delete m_Data;
 	}
 
+	void Font::Init()
+	{
+		s_Workers = CreateScope<ThreadPool>();
+	}
+
+	void Font::Shutdown()
+	{
+		s_Workers.reset();
+	}
+
+	void Font::RequestGlyph(uint32_t codepoint)
+	{
+		if (!m_GlyphSource || !s_Workers || GetGlyph(codepoint))
+			return;
+
+		if (!m_RequestedGlyphs.insert(codepoint).second)
+			return;
+
+		s_Workers->Submit([source = m_GlyphSource, weakFont = weak_from_this(), codepoint]
+		{
+			GeneratedGlyph generated = Utils::GenerateGlyph(*source, codepoint);
+			if (!generated.Found)
+			{
+				HZ_CORE_WARN("Font {0} has no glyph for U+{1:04X}", source->Path, codepoint);
+				return;
+			}
+
+			Application::Get().SubmitToMainThread([weakFont, generated = std::move(generated)]
+			{
+				if (auto font = weakFont.lock())
+					font->AddGeneratedGlyph(generated);
+			});
+		});
+	}
+
+	void Font::AddGlyph(uint32_t codepoint, const FontGlyph& glyph)
+	{
+		HZ_CORE_ASSERT(m_Glyphs.size() < INVALID_GLYPH, "Too many glyphs");
+
+		const uint32_t block = codepoint >> GLYPH_BLOCK_BITS;
+		if (block >= m_GlyphBlocks.size())
+			m_GlyphBlocks.resize(block + 1);
+
+		if (!m_GlyphBlocks[block])
+		{
+			m_GlyphBlocks[block] = CreateScope<GlyphBlock>();
+			m_GlyphBlocks[block]->fill(INVALID_GLYPH);
+		}
+
+		(*m_GlyphBlocks[block])[codepoint & GLYPH_BLOCK_MASK] = (uint16_t)m_Glyphs.size();
+		m_Glyphs.push_back(glyph);
+	}
+
+	void Font::AddGeneratedGlyph(const GeneratedGlyph& generated)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (GetGlyph(generated.Glyph.Codepoint) || m_AtlasPages.empty())
+			return;
+
+		const MSDFMetrics& metrics = m_Data->Metrics;
+		const double fsScale = 1.0 / (metrics.AscenderY - metrics.DescenderY);
+		const MSDFGlyph& glyph = generated.Glyph;
+
+		FontGlyph fontGlyph;
+		fontGlyph.Advance = (float)(glyph.Advance * fsScale);
+
+		// Whitespace only advances the pen
+		if (generated.Width > 0 && generated.Height > 0)
+		{
+			uint32_t x, y;
+			fontGlyph.Page = AllocateAtlasRegion(generated.Width, generated.Height, x, y);
+
+			const Ref<Texture2D>& page = m_AtlasPages[fontGlyph.Page].Texture;
+			page->SetSubData(generated.Pixels.data(), x, y, generated.Width, generated.Height);
+
+			const glm::vec2 offset((float)x, (float)y);
+			const glm::vec2 texelSize(1.0f / page->GetWidth(), 1.0f / page->GetHeight());
+			fontGlyph.QuadMin = glm::vec2(glyph.PlaneBounds[0] * fsScale, glyph.PlaneBounds[1] * fsScale);
+			fontGlyph.QuadMax = glm::vec2(glyph.PlaneBounds[2] * fsScale, glyph.PlaneBounds[3] * fsScale);
+			fontGlyph.TexCoordMin = (glm::vec2((float)glyph.AtlasBounds[0], (float)glyph.AtlasBounds[1]) + offset) * texelSize;
+			fontGlyph.TexCoordMax = (glm::vec2((float)glyph.AtlasBounds[2], (float)glyph.AtlasBounds[3]) + offset) * texelSize;
+		}
+
+		AddGlyph(glyph.Codepoint, fontGlyph);
+		m_Generation++;
+	}
+
+	uint32_t Font::AllocateAtlasRegion(uint32_t width, uint32_t height, uint32_t& outX, uint32_t& outY)
+	{
+		HZ_CORE_ASSERT(width <= s_DynamicPageSize && height <= s_DynamicPageSize, "Glyph doesn't fit in an atlas page");
+
+		// Only the newest page is packed into, the older ones only have scraps left
+		const auto fits = [width, height](AtlasPage& page)
+		{
+			if (page.ShelfX + width > s_DynamicPageSize)
+			{
+				page.ShelfX = 0;
+				page.ShelfY += page.ShelfHeight + s_DynamicPagePadding;
+				page.ShelfHeight = 0;
+			}
+
+			return page.ShelfY + height <= s_DynamicPageSize;
+		};
+
+		if (m_AtlasPages.size() < 2 || !fits(m_AtlasPages.back()))
+		{
+			// Zero is outside of every glyph, so the unused parts of the page are transparent
+			const std::vector<uint8_t> clear((size_t)s_DynamicPageSize * s_DynamicPageSize * 3, 0);
+			m_AtlasPages.push_back({ Utils::CreateAtlasTexture(s_DynamicPageSize, s_DynamicPageSize, clear.data()) });
+			HZ_CORE_TRACE("Added atlas page {0} to font {1}", m_AtlasPages.size() - 1, m_GlyphSource->Path);
+		}
+
+		AtlasPage& page = m_AtlasPages.back();
+		outX = page.ShelfX;
+		outY = page.ShelfY;
+		page.ShelfX += width + s_DynamicPagePadding;
+		page.ShelfHeight = std::max(page.ShelfHeight, height);
+
+		return (uint32_t)m_AtlasPages.size() - 1;
+	}
+
+	void Font::BuildGlyphTables()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		m_Glyphs.clear();
+		m_GlyphBlocks.clear();
+		m_KerningTable.clear();
+
+		if (m_Data->Glyphs.empty())
+			return;
+
+		const MSDFMetrics& metrics = m_Data->Metrics;
+		const double fsScale = 1.0 / (metrics.AscenderY - metrics.DescenderY);
+		const Ref<Texture2D>& atlasTexture = m_AtlasPages[0].Texture;
+		const glm::vec2 texelSize(1.0f / atlasTexture->GetWidth(), 1.0f / atlasTexture->GetHeight());
+
+		m_LineHeight = (float)(fsScale * metrics.LineHeight);
+
+		m_Glyphs.reserve(m_Data->Glyphs.size());
+
+		for (const auto& [codepoint, glyph] : m_Data->Glyphs)
+		{
+			FontGlyph fontGlyph;
+			fontGlyph.QuadMin = glm::vec2(glyph.PlaneBounds[0] * fsScale, glyph.PlaneBounds[1] * fsScale);
+			fontGlyph.QuadMax = glm::vec2(glyph.PlaneBounds[2] * fsScale, glyph.PlaneBounds[3] * fsScale);
+			fontGlyph.TexCoordMin = glm::vec2((float)glyph.AtlasBounds[0], (float)glyph.AtlasBounds[1]) * texelSize;
+			fontGlyph.TexCoordMax = glm::vec2((float)glyph.AtlasBounds[2], (float)glyph.AtlasBounds[3]) * texelSize;
+			fontGlyph.Advance = (float)(glyph.Advance * fsScale);
+			AddGlyph(codepoint, fontGlyph);
+		}
+
+		if (m_Data->Kerning.empty())
+			return;
+
+		size_t capacity = 2;
+		uint32_t bits = 1;
+		while (capacity < m_Data->Kerning.size() * 2)
+		{
+			capacity <<= 1;
+			bits++;
+		}
+
+		m_KerningTable.resize(capacity);
+		m_KerningShift = 64 - bits;
+
+		const size_t mask = capacity - 1;
+		for (const auto& [pair, advance] : m_Data->Kerning)
+		{
+			const uint64_t key = GetKerningKey(pair.first, pair.second);
+			if (key == 0)
+				continue;
+
+			size_t slot = GetKerningSlot(key);
+			while (m_KerningTable[slot].Key != 0)
+				slot = (slot + 1) & mask;
+
+			m_KerningTable[slot] = { key, (float)(advance * fsScale) };
+		}
+	}
+
 	Ref<Font> Font::GetDefault()
 	{
-		static Ref<Font> defaultFont;
-		if (!defaultFont)
-			defaultFont = CreateRef<Font>("assets/fonts/opensans/OpenSans-Regular.ttf");
+		// Initialized once even when first reached from a scene loading thread, the Application
+		// requests it during startup anyway so the asset is always loaded on the main thread
+		static const Ref<Font> defaultFont = []
+		{
+			// Never released so it's never evicted
+			const AssetHandle handle = AssetManager::ImportAsset("assets/fonts/opensans/OpenSans-Regular.ttf", AssetType::Font);
+			AssetManager::Acquire(handle);
+			return AssetManager::GetAsset<Font>(handle);
+		}();
 
 		return defaultFont;
 	}
@@ -3,23 +3,150 @@
 #include "Hazel/Core/FileSystem.h"
 #include "Hazel/Renderer/Texture.h"
 
+#include <glm/glm.hpp>
+
+#include <array>
+#include <unordered_set>
+
 namespace Hazel
 {
 	struct MSDFData;
+	struct FontAtlasData;
+	struct FontGlyphSource;
+	struct GeneratedGlyph;
 
-	class Font
+	// Glyph ready for layout, everything in text units where 1 is the distance from the ascender to the descender
+	struct FontGlyph
+	{
+		// Relative to the pen position on the baseline
+		glm::vec2 QuadMin, QuadMax;
+		// Normalized coordinates in the atlas page
+		glm::vec2 TexCoordMin, TexCoordMax;
+		float Advance = 0.0f;
+		uint32_t Page = 0;
+	};
+
+	// The charset loaded up front (Latin) is generated into a tight atlas that lives in the font cache.
+	// Any other glyph is generated the first time it's requested, on a worker thread, and packed into
+	// dynamic atlas pages that are added as they fill up.
+	class Font : public std::enable_shared_from_this<Font>
 	{
 	public:
-		Font(const FilePath& fontPath);
+		// With loadAsync the font stays empty, use CreateAsync to load it in the background
+		Font(const FilePath& fontPath, bool loadAsync = false);
 		~Font();
 
+		// Owns the worker threads loading fonts and generating glyphs on demand
+		static void Init();
+		static void Shutdown();
+
+		// The atlas is loaded or generated on a worker and uploaded on the main thread once it's ready.
+		// Until then the font has no glyphs, the generation changes when it's loaded
+		static Ref<Font> CreateAsync(const FilePath& fontPath);
+
+		bool IsLoaded() const { return !m_AtlasPages.empty(); }
+
 		const MSDFData* GetMSDFData() const { return m_Data; }
-		Ref<Texture2D> GetAtlasTexture() const { return m_AtlasTexture; }
+		// The page holding the preloaded charset
+		Ref<Texture2D> GetAtlasTexture() const { return m_AtlasPages.empty() ? nullptr : m_AtlasPages[0].Texture; }
+		uint32_t GetAtlasPageCount() const { return (uint32_t)m_AtlasPages.size(); }
+		const Ref<Texture2D>& GetAtlasPage(uint32_t page) const { return m_AtlasPages[page].Texture; }
+
+		// nullptr if the glyph isn't in the atlas (yet), see RequestGlyph
+		const FontGlyph* GetGlyph(uint32_t codepoint) const
+		{
+			const uint32_t block = codepoint >> GLYPH_BLOCK_BITS;
+			if (block >= m_GlyphBlocks.size() || !m_GlyphBlocks[block])
+				return nullptr;
+
+			const uint16_t index = (*m_GlyphBlocks[block])[codepoint & GLYPH_BLOCK_MASK];
+			return index != INVALID_GLYPH ? &m_Glyphs[index] : nullptr;
+		}
+
+		// Starts generating a glyph that isn't in the atlas. It shows up in GetGlyph a few frames later
+		// and the generation changes, codepoints the font has no glyph for are only tried once.
+		void RequestGlyph(uint32_t codepoint);
+
+		// Changes every time glyphs are added, layouts built against an older generation are stale
+		uint32_t GetGeneration() const { return m_Generation; }
+
+		// Added to the advance of the first glyph when it's followed by the second one
+		float GetKerning(uint32_t codepoint, uint32_t nextCodepoint) const
+		{
+			if (m_KerningTable.empty())
+				return 0.0f;
+
+			const uint64_t key = GetKerningKey(codepoint, nextCodepoint);
+			const size_t mask = m_KerningTable.size() - 1;
+			for (size_t slot = GetKerningSlot(key); ; slot = (slot + 1) & mask)
+			{
+				const KerningEntry& entry = m_KerningTable[slot];
+				if (entry.Key == key)
+					return entry.Advance;
+				if (entry.Key == 0)
+					return 0.0f;
+			}
+		}
+
+		// Distance between two baselines, in the same units as the glyphs
+		float GetLineHeight() const { return m_LineHeight; }
 
 		static Ref<Font> GetDefault();
 
 	private:
+		// Main thread, takes the layout and uploads the atlas as page 0
+		void UploadAtlas(FontAtlasData& atlas);
+		// Flattens the glyph layout in m_Data into the lookup tables above
+		void BuildGlyphTables();
+
+		void AddGlyph(uint32_t codepoint, const FontGlyph& glyph);
+		// Main thread, packs a glyph generated by a worker into a dynamic page
+		void AddGeneratedGlyph(const GeneratedGlyph& generated);
+		// Finds room for a width x height region, adding a page if none has it
+		uint32_t AllocateAtlasRegion(uint32_t width, uint32_t height, uint32_t& outX, uint32_t& outY);
+
+		static uint64_t GetKerningKey(uint32_t codepoint, uint32_t nextCodepoint) { return ((uint64_t)codepoint << 32) | nextCodepoint; }
+		size_t GetKerningSlot(uint64_t key) const { return (size_t)((key * 0x9E3779B97F4A7C15ull) >> m_KerningShift); }
+
+	private:
+		static constexpr uint16_t INVALID_GLYPH = 0xFFFF;
+		static constexpr uint32_t GLYPH_BLOCK_BITS = 8;
+		static constexpr uint32_t GLYPH_BLOCK_MASK = (1 << GLYPH_BLOCK_BITS) - 1;
+
+		using GlyphBlock = std::array<uint16_t, 1 << GLYPH_BLOCK_BITS>;
+
+		struct AtlasPage
+		{
+			Ref<Texture2D> Texture;
+			// Glyphs are packed left to right in rows (shelves), a new shelf starts above the tallest glyph of the current one
+			uint32_t ShelfX = 0, ShelfY = 0, ShelfHeight = 0;
+		};
+
+		struct KerningEntry
+		{
+			// 0 marks an empty slot, no font has a glyph for codepoint 0
+			uint64_t Key = 0;
+			float Advance = 0.0f;
+		};
+
 		MSDFData* m_Data = nullptr;
-		Ref<Texture2D> m_AtlasTexture;
+		// Page 0 is the preloaded atlas and is never packed into, the rest are dynamic
+		std::vector<AtlasPage> m_AtlasPages;
+
+		// Two levels indexed by the codepoint's high and low bits, blocks without glyphs aren't allocated.
+		// Holds indices into m_Glyphs
+		std::vector<Scope<GlyphBlock>> m_GlyphBlocks;
+		std::vector<FontGlyph> m_Glyphs;
+
+		// Only touched on the main thread, workers hand their results back through SubmitToMainThread
+		Ref<FontGlyphSource> m_GlyphSource;
+		std::unordered_set<uint32_t> m_RequestedGlyphs;
+		uint32_t m_Generation = 0;
+
+		// Open addressing with linear probing, the size is a power of two at most half full
+		std::vector<KerningEntry> m_KerningTable;
+		uint32_t m_KerningShift = 63;
+
+		float m_LineHeight = 0.0f;
 	};
 }
@@ -46,6 +46,23 @@ namespace Hazel
 		bool SwapChainTarget = false;
 	};
 	
+	// Pixels of an integer attachment being copied back from the GPU.
+	// The copy goes through a pixel pack buffer guarded by a fence, so requesting it never stalls,
+	// it's usually ready one or two frames later.
+	class FramebufferReadback
+	{
+	public:
+		virtual ~FramebufferReadback() = default;
+
+		// Checks without waiting, the pixels are fetched the first time this returns true
+		virtual bool IsReady() = 0;
+
+		// Width x height values, bottom row first. Empty until IsReady returned true
+		virtual const std::vector<int32_t>& GetPixels() const = 0;
+		virtual uint32_t GetWidth() const = 0;
+		virtual uint32_t GetHeight() const = 0;
+	};
+
 	class Framebuffer
 	{
 	public:
@@ -55,7 +72,10 @@ namespace Hazel
 		virtual void Unbind() = 0;
 
 		virtual void Resize(uint32_t width, uint32_t height) = 0;
+		// Blocks until the GPU has finished rendering to the attachment, prefer ReadPixelsAsync
 		virtual int32_t ReadPixel(uint32_t attachmentIndex, int32_t x, int32_t y) = 0;
+		// The region is clamped to the framebuffer, nullptr if nothing of it is inside
+		virtual Ref<FramebufferReadback> ReadPixelsAsync(uint32_t attachmentIndex, int32_t x, int32_t y, uint32_t width = 1, uint32_t height = 1) = 0;
 
 		virtual void ClearAttachment(uint32_t attachmentIndex, int32_t value) = 0;
 
@@ -1,13 +1,37 @@
 #pragma once
 
-#undef INFINITE
-#include "FontGeometry.h"
+#include <map>
 
 namespace Hazel
 {
+	struct MSDFMetrics
+	{
+		double EmSize = 0.0;
+		double AscenderY = 0.0;
+		double DescenderY = 0.0;
+		double LineHeight = 0.0;
+		double UnderlineY = 0.0;
+		double UnderlineThickness = 0.0;
+	};
+
+	// Bounds are left, bottom, right, top
+	struct MSDFGlyph
+	{
+		uint32_t Codepoint = 0;
+		double Advance = 0.0;
+		// Relative to the pen position, in the font's units
+		double PlaneBounds[4] = {};
+		// In atlas pixels
+		double AtlasBounds[4] = {};
+	};
+
+	// Layout of a font's glyphs in its atlas, as generated by msdf-atlas-gen.
+	// Plain data so it can be stored in the font cache, Font flattens it into its lookup tables for layout.
 	struct MSDFData
 	{
-		std::vector<msdf_atlas::GlyphGeometry> Glyphs;
-		msdf_atlas::FontGeometry FontGeometry;
+		MSDFMetrics Metrics;
+		std::map<uint32_t, MSDFGlyph> Glyphs;
+		// Added to the first glyph's advance, only pairs with a non zero adjustment are stored
+		std::map<std::pair<uint32_t, uint32_t>, double> Kerning;
 	};
 }
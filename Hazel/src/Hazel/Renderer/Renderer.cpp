@@ -1,23 +1,29 @@
 #include "hzpch.h"
 #include "Hazel/Renderer/Renderer.h"
 
+#include "Hazel/Renderer/Font.h"
 #include "Hazel/Renderer/Renderer2D.h"
+#include "Hazel/Renderer/TextureLoader.h"
 
 namespace Hazel
 {
     Scope<Renderer::SceneData> Renderer::s_SceneData = CreateScope<Renderer::SceneData>();
 
-    void Renderer::Init()
+    void Renderer::Init(const RendererConfig& config)
     {
         HZ_PROFILE_FUNCTION();
     	
         RenderCommand::Init();
-        Renderer2D::Init();
+        TextureLoader::Init();
+        Font::Init();
+        Renderer2D::Init(config);
     }
 
     void Renderer::Shutdown()
     {
         Renderer2D::Shutdown();
+        Font::Shutdown();
+        TextureLoader::Shutdown();
     }
 
     void Renderer::OnWindowResize(uint32_t width, uint32_t height)
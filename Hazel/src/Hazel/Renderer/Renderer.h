@@ -6,10 +6,17 @@
 
 namespace Hazel
 {
+    struct RendererConfig
+    {
+        // Renders each primitive's entity id into the framebuffer's integer attachment, the editor uses it for mouse picking.
+        // When it's off the ids aren't uploaded at all and the shaders are built without them
+        bool EntityIds = false;
+    };
+
     class Renderer
     {
     public:
-        static void Init();
+        static void Init(const RendererConfig& config = {});
         static void Shutdown();
     	
         static void OnWindowResize(uint32_t width, uint32_t height);
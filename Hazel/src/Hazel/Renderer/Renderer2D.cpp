@@ -1,7 +1,8 @@
 #include "hzpch.h"
 #include "Hazel/Renderer/Renderer2D.h"
 
-#include "Hazel/Renderer/MSDFData.h"
+#include "Hazel/Asset/AssetManager.h"
+
 #include "Hazel/Renderer/RenderCommand.h"
 #include "Hazel/Renderer/Shader.h"
 #include "Hazel/Renderer/UniformBuffer.h"
@@ -19,9 +20,6 @@ namespace Hazel
 		glm::vec2 TexCoord;
 		uint32_t TexIndex;
 		float TilingFactor;
-
-		// Editor-only
-		int32_t EntityId;
 	};
 
 	struct CircleVertex
@@ -31,18 +29,12 @@ namespace Hazel
 		float Thickness;
 		float Fade;
 		glm::vec4 Color;
-
-		// Editor-only
-		int32_t EntityId;
 	};
 
 	struct LineVertex
 	{
 		glm::vec3 Position;
 		glm::vec4 Color;
-
-		// Editor-only
-		int32_t EntityId;
 	};
 
 	struct TextVertex
@@ -50,9 +42,16 @@ namespace Hazel
 		glm::vec3 Position;
 		glm::vec4 Color;
 		glm::vec2 TexCoord;
-		
-		// Editor-only
-		int32_t EntityId;
+		int32_t AtlasIndex;
+	};
+
+	// Entity ids live in a vertex buffer of their own next to each primitive's vertices.
+	// Without RendererConfig::EntityIds it's never created, so runtime vertices carry nothing editor-only
+	struct EntityIdBuffer
+	{
+		Ref<VertexBuffer> Buffer;
+		int32_t* Base = nullptr;
+		int32_t* Ptr = nullptr;
 	};
 	
 	struct Renderer2DData
@@ -61,6 +60,8 @@ namespace Hazel
 		static constexpr uint32_t MAX_VERTICES = MAX_QUADS * 4;
 		static constexpr uint32_t MAX_INDICES = MAX_QUADS * 6;
 		static constexpr uint32_t MAX_TEXTURE_SLOTS = 32;
+		// Has to match the size of u_FontAtlases in Renderer2D_Text.glsl
+		static constexpr uint32_t MAX_FONT_ATLAS_SLOTS = 16;
 
 		// Quads
 		Ref<VertexArray> QuadVertexArray;
@@ -71,6 +72,7 @@ namespace Hazel
 		uint32_t QuadIndexCount = 0;
 		QuadVertex* QuadVertexBufferBase = nullptr;
 		QuadVertex* QuadVertexBufferPtr = nullptr;
+		EntityIdBuffer QuadEntityIds;
 
 		// Circles
 		Ref<VertexArray> CircleVertexArray;
@@ -80,6 +82,7 @@ namespace Hazel
 		uint32_t CircleIndexCount = 0;
 		CircleVertex* CircleVertexBufferBase = nullptr;
 		CircleVertex* CircleVertexBufferPtr = nullptr;
+		EntityIdBuffer CircleEntityIds;
 
 		// Lines
 		Ref<VertexArray> LineVertexArray;
@@ -89,6 +92,7 @@ namespace Hazel
 		uint32_t LineVertexCount = 0;
 		LineVertex* LineVertexBufferBase = nullptr;
 		LineVertex* LineVertexBufferPtr = nullptr;
+		EntityIdBuffer LineEntityIds;
 
 		float LineWidth = 2.0f;
 
@@ -100,11 +104,14 @@ namespace Hazel
 		uint32_t TextIndexCount = 0;
 		TextVertex* TextVertexBufferBase = nullptr;
 		TextVertex* TextVertexBufferPtr = nullptr;
+		EntityIdBuffer TextEntityIds;
 
 		Ref<Texture2D> TextureSlots[MAX_TEXTURE_SLOTS];
 		uint32_t TextureSlotIndex = 1; // 0 = white texture
 
-		Ref<Texture2D> FontAtlasTexture;
+		// Text draws after quads in a flush, so it reuses the same texture units
+		Ref<Texture2D> FontAtlasSlots[MAX_FONT_ATLAS_SLOTS];
+		uint32_t FontAtlasSlotIndex = 0;
 
 		glm::vec4 QuadVertexPositions[4]
 		{
@@ -122,11 +129,45 @@ namespace Hazel
 		};
 		CameraData CameraBuffer;
 		Ref<UniformBuffer> CameraUniformBuffer;
+
+		// Owns the shaders above and reloads them when their source changes
+		ShaderLibrary Shaders;
 	};
 
 	static Renderer2DData* s_Data;
+
+	// Has to be added after the vertex buffer, a_EntityId is the last attribute of every shader
+	static void CreateEntityIdBuffer(EntityIdBuffer& ids, const Ref<VertexArray>& vertexArray)
+	{
+		ids.Buffer = VertexBuffer::Create(Renderer2DData::MAX_VERTICES * sizeof(int32_t));
+		ids.Buffer->SetLayout({ { ShaderDataType::Int, "a_EntityId" } });
+		vertexArray->AddVertexBuffer(ids.Buffer);
+
+		ids.Base = new int32_t[Renderer2DData::MAX_VERTICES];
+		ids.Ptr = ids.Base;
+	}
+
+	static void WriteEntityIds(EntityIdBuffer& ids, int32_t entityId, uint32_t vertexCount)
+	{
+		if (!ids.Base)
+			return;
+
+		std::fill_n(ids.Ptr, vertexCount, entityId);
+		ids.Ptr += vertexCount;
+	}
+
+	// Returns the uploaded size
+	static uint32_t UploadEntityIds(EntityIdBuffer& ids)
+	{
+		if (!ids.Base)
+			return 0;
+
+		const auto dataSize = (uint32_t)((uint8_t*)ids.Ptr - (uint8_t*)ids.Base);
+		ids.Buffer->SetData(ids.Base, dataSize);
+		return dataSize;
+	}
 	
-	void Renderer2D::Init()
+	void Renderer2D::Init(const RendererConfig& config)
 	{
 		HZ_PROFILE_FUNCTION();
 
@@ -144,9 +185,10 @@ namespace Hazel
 					{ ShaderDataType::Float2,	"a_TexCoord"		},
 					{ ShaderDataType::Int,		"a_TexIndex"		},
 					{ ShaderDataType::Float,	"a_TilingFactor"	},
-					{ ShaderDataType::Int,		"a_EntityId"		},
 				});
 			s_Data->QuadVertexArray->AddVertexBuffer(s_Data->QuadVertexBuffer);
+			if (config.EntityIds)
+				CreateEntityIdBuffer(s_Data->QuadEntityIds, s_Data->QuadVertexArray);
 
 			s_Data->QuadVertexBufferBase = new QuadVertex[Renderer2DData::MAX_VERTICES];
 
@@ -183,9 +225,10 @@ namespace Hazel
 					{ ShaderDataType::Float,	"a_Thickness"		},
 					{ ShaderDataType::Float,	"a_Fade"			},
 					{ ShaderDataType::Float4,	"a_Color"			},
-					{ ShaderDataType::Int,		"a_EntityId"		}
 				});
 			s_Data->CircleVertexArray->AddVertexBuffer(s_Data->CircleVertexBuffer);
+			if (config.EntityIds)
+				CreateEntityIdBuffer(s_Data->CircleEntityIds, s_Data->CircleVertexArray);
 
 			s_Data->CircleVertexBufferBase = new CircleVertex[Renderer2DData::MAX_VERTICES];
 			s_Data->CircleVertexArray->SetIndexBuffer(s_Data->QuadVertexArray->GetIndexBuffer()); // Use quad IB
@@ -200,9 +243,10 @@ namespace Hazel
 				{
 					{ ShaderDataType::Float3,	"a_Position"	},
 					{ ShaderDataType::Float4,	"a_Color"		},
-					{ ShaderDataType::Int,		"a_EntityId"	}
 				});
 			s_Data->LineVertexArray->AddVertexBuffer(s_Data->LineVertexBuffer);
+			if (config.EntityIds)
+				CreateEntityIdBuffer(s_Data->LineEntityIds, s_Data->LineVertexArray);
 
 			s_Data->LineVertexBufferBase = new LineVertex[Renderer2DData::MAX_VERTICES];
 		}
@@ -217,9 +261,11 @@ namespace Hazel
 					{ ShaderDataType::Float3,	"a_Position"		},
 					{ ShaderDataType::Float4,	"a_Color"			},
 					{ ShaderDataType::Float2,	"a_TexCoord"		},
-					{ ShaderDataType::Int,		"a_EntityId"		},
+					{ ShaderDataType::Int,		"a_AtlasIndex"		},
 				});
 			s_Data->TextVertexArray->AddVertexBuffer(s_Data->TextVertexBuffer);
+			if (config.EntityIds)
+				CreateEntityIdBuffer(s_Data->TextEntityIds, s_Data->TextVertexArray);
 
 			s_Data->TextVertexBufferBase = new TextVertex[Renderer2DData::MAX_VERTICES];
 
@@ -248,10 +294,27 @@ namespace Hazel
 		uint32_t whiteTextureData = 0xffffffff;
 		s_Data->WhiteTexture->SetData(&whiteTextureData, sizeof(uint32_t));
 		
-		s_Data->QuadShader = Shader::Create("assets/shaders/Renderer2D_Quad.glsl");
-		s_Data->CircleShader = Shader::Create("assets/shaders/Renderer2D_Circle.glsl");
-		s_Data->LineShader = Shader::Create("assets/shaders/Renderer2D_Line.glsl");
-		s_Data->TextShader = Shader::Create("assets/shaders/Renderer2D_Text.glsl");
+		std::vector<std::string> shaderDefines;
+		if (config.EntityIds)
+			shaderDefines.emplace_back("HZ_ENTITY_ID");
+
+		const auto shaders = Shader::CreateAll({
+			"assets/shaders/Renderer2D_Quad.glsl",
+			"assets/shaders/Renderer2D_Circle.glsl",
+			"assets/shaders/Renderer2D_Line.glsl",
+			"assets/shaders/Renderer2D_Text.glsl"
+		}, shaderDefines);
+		s_Data->QuadShader = shaders[0];
+		s_Data->CircleShader = shaders[1];
+		s_Data->LineShader = shaders[2];
+		s_Data->TextShader = shaders[3];
+
+		for (const auto& shader : shaders)
+			s_Data->Shaders.Add(shader);
+
+#ifndef HZ_DIST
+		s_Data->Shaders.EnableHotReload("assets/shaders");
+#endif
 
 		s_Data->CameraUniformBuffer = UniformBuffer::Create(sizeof(Renderer2DData::CameraData), 0);
 
@@ -264,6 +327,14 @@ namespace Hazel
 
 		delete[] s_Data->QuadVertexBufferBase;
 		delete[] s_Data->CircleVertexBufferBase;
+		delete[] s_Data->LineVertexBufferBase;
+		delete[] s_Data->TextVertexBufferBase;
+
+		delete[] s_Data->QuadEntityIds.Base;
+		delete[] s_Data->CircleEntityIds.Base;
+		delete[] s_Data->LineEntityIds.Base;
+		delete[] s_Data->TextEntityIds.Base;
+
 		delete s_Data;
 	}
 
@@ -308,17 +379,22 @@ namespace Hazel
 	{
 		s_Data->QuadIndexCount = 0;
 		s_Data->QuadVertexBufferPtr = s_Data->QuadVertexBufferBase;
+		s_Data->QuadEntityIds.Ptr = s_Data->QuadEntityIds.Base;
 
 		s_Data->CircleIndexCount = 0;
 		s_Data->CircleVertexBufferPtr = s_Data->CircleVertexBufferBase;
+		s_Data->CircleEntityIds.Ptr = s_Data->CircleEntityIds.Base;
 
 		s_Data->LineVertexCount = 0;
 		s_Data->LineVertexBufferPtr = s_Data->LineVertexBufferBase;
+		s_Data->LineEntityIds.Ptr = s_Data->LineEntityIds.Base;
 
 		s_Data->TextIndexCount = 0;
 		s_Data->TextVertexBufferPtr = s_Data->TextVertexBufferBase;
+		s_Data->TextEntityIds.Ptr = s_Data->TextEntityIds.Base;
 
 		s_Data->TextureSlotIndex = 1;
+		s_Data->FontAtlasSlotIndex = 0;
 	}
 
 	void Renderer2D::Flush()
@@ -327,6 +403,7 @@ namespace Hazel
 		{
 			const auto dataSize = (uint32_t)((uint8_t*)s_Data->QuadVertexBufferPtr - (uint8_t*)s_Data->QuadVertexBufferBase);
 			s_Data->QuadVertexBuffer->SetData(s_Data->QuadVertexBufferBase, dataSize);
+			s_Data->Stats.VertexBytes += dataSize + UploadEntityIds(s_Data->QuadEntityIds);
 
 			for (uint32_t i = 0; i < s_Data->TextureSlotIndex; i++)
 				s_Data->TextureSlots[i]->Bind(i);
@@ -340,6 +417,7 @@ namespace Hazel
 		{
 			const auto dataSize = (uint32_t)((uint8_t*)s_Data->CircleVertexBufferPtr - (uint8_t*)s_Data->CircleVertexBufferBase);
 			s_Data->CircleVertexBuffer->SetData(s_Data->CircleVertexBufferBase, dataSize);
+			s_Data->Stats.VertexBytes += dataSize + UploadEntityIds(s_Data->CircleEntityIds);
 
 			s_Data->CircleShader->Bind();
 			RenderCommand::DrawIndexed(s_Data->CircleVertexArray, s_Data->CircleIndexCount);
@@ -350,6 +428,7 @@ namespace Hazel
 		{
 			const auto dataSize = (uint32_t)((uint8_t*)s_Data->LineVertexBufferPtr - (uint8_t*)s_Data->LineVertexBufferBase);
 			s_Data->LineVertexBuffer->SetData(s_Data->LineVertexBufferBase, dataSize);
+			s_Data->Stats.VertexBytes += dataSize + UploadEntityIds(s_Data->LineEntityIds);
 
 			s_Data->LineShader->Bind();
 			RenderCommand::SetLineWidth(s_Data->LineWidth);
@@ -361,8 +440,10 @@ namespace Hazel
 		{
 			const auto dataSize = (uint32_t)((uint8_t*)s_Data->TextVertexBufferPtr - (uint8_t*)s_Data->TextVertexBufferBase);
 			s_Data->TextVertexBuffer->SetData(s_Data->TextVertexBufferBase, dataSize);
+			s_Data->Stats.VertexBytes += dataSize + UploadEntityIds(s_Data->TextEntityIds);
 
-			s_Data->FontAtlasTexture->Bind(0);
+			for (uint32_t i = 0; i < s_Data->FontAtlasSlotIndex; i++)
+				s_Data->FontAtlasSlots[i]->Bind(i);
 
 			s_Data->TextShader->Bind();
 			RenderCommand::DrawIndexed(s_Data->TextVertexArray, s_Data->TextIndexCount);
@@ -523,10 +604,11 @@ namespace Hazel
 			s_Data->CircleVertexBufferPtr->Thickness = thickness;
 			s_Data->CircleVertexBufferPtr->Fade = fade;
 			s_Data->CircleVertexBufferPtr->Color = color;
-			s_Data->CircleVertexBufferPtr->EntityId = entityId;
 			s_Data->CircleVertexBufferPtr++;
 		}
 
+		WriteEntityIds(s_Data->CircleEntityIds, entityId, 4);
+
 		s_Data->CircleIndexCount += 6;
 
 		s_Data->Stats.CircleCount++;
@@ -536,14 +618,14 @@ namespace Hazel
 	{
 		s_Data->LineVertexBufferPtr->Position = p0;
 		s_Data->LineVertexBufferPtr->Color = color;
-		s_Data->LineVertexBufferPtr->EntityId = entityId;
 		s_Data->LineVertexBufferPtr++;
 
 		s_Data->LineVertexBufferPtr->Position = p1;
 		s_Data->LineVertexBufferPtr->Color = color;
-		s_Data->LineVertexBufferPtr->EntityId = entityId;
 		s_Data->LineVertexBufferPtr++;
 
+		WriteEntityIds(s_Data->LineEntityIds, entityId, 2);
+
 		s_Data->LineVertexCount += 2;
 	}
 
@@ -581,129 +663,95 @@ namespace Hazel
 			NextBatch();
 
 		constexpr glm::vec2 textureCoords[]{ { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
-		const uint32_t textureIndex = src.Texture ? FindTextureIndex(src.Texture) : 0;
+		const Ref<Texture2D> texture = AssetManager::GetAsset<Texture2D>(src.Texture);
+		const uint32_t textureIndex = texture ? FindTextureIndex(texture) : 0;
 
 		LoadQuadVertexData(transform, src.Color, textureCoords, textureIndex, src.TilingFactor, entityId);
 	}
 
 	void Renderer2D::DrawString(const std::string& string, Ref<Font> font, const glm::mat4& transform, const TextParams& textParams, int32_t entityId)
 	{
-		const auto& fontGeometry = font->GetMSDFData()->FontGeometry;
-		const auto& metrics = fontGeometry.getMetrics();
-		Ref<Texture2D> fontAtlas = font->GetAtlasTexture();
+		// One-off text, anything drawn every frame should keep its TextLayout around instead
+		TextLayout layout;
+		layout.Update(string, font, textParams.Kerning, textParams.LineSpacing);
+		DrawString(layout, transform, textParams.Color, entityId);
+	}
+
+	void Renderer2D::DrawString(const std::string& string, const glm::mat4& transform, const TextComponent& component, int32_t entityId)
+	{
+		component.Layout.Update(string, component.FontAsset, component.Kerning, component.LineSpacing);
+		DrawString(component.Layout, transform, component.Color, entityId);
+	}
 
-		s_Data->FontAtlasTexture = fontAtlas;
+	void Renderer2D::DrawString(const TextLayout& layout, const glm::mat4& transform, const glm::vec4& color, int32_t entityId)
+	{
+		HZ_PROFILE_FUNCTION();
 
-		double x = 0.0;
-		double y = 0.0;
-		double fsScale = 1.0 / (metrics.ascenderY - metrics.descenderY);
-		double lineHeightOffset = 0.0;
+		const auto& glyphs = layout.GetGlyphs();
+		if (glyphs.empty())
+			return;
 
-		double spaceGlyphAdvance = fontGeometry.getGlyph(' ')->getAdvance();
+		const Ref<Font>& font = layout.GetFont();
 
-		for (size_t i = 0; i < string.size(); i++)
-		{
-			char character = string[i];
+		// The quads lie flat in the text's local space, so a corner only needs the x and y axes and the origin
+		const glm::vec3 origin = transform[3];
+		const glm::vec3 axisX = transform[0];
+		const glm::vec3 axisY = transform[1];
 
-			if (character == '\r')
-				continue;
+		// Consecutive glyphs are almost always on the same atlas page, the slot is only looked up when it changes
+		constexpr uint32_t noPage = std::numeric_limits<uint32_t>::max();
+		uint32_t currentPage = noPage;
+		int32_t atlasIndex = 0;
 
-			if (character == '\n')
+		for (const TextLayout::Glyph& glyph : glyphs)
+		{
+			// Long strings are split across as many batches as they need
+			if (s_Data->TextIndexCount >= Renderer2DData::MAX_INDICES)
 			{
-				x = 0;
-				y -= fsScale * metrics.lineHeight + lineHeightOffset + textParams.LineSpacing;
-				continue;
+				NextBatch();
+				currentPage = noPage;
 			}
 
-			if (character == ' ')
+			if (glyph.Page != currentPage)
 			{
-				double advance = spaceGlyphAdvance;
-				if (i < string.size() - 1)
-				{
-					char nextCharacter = string[i + 1];
-					double nextCharAdvance;
-					fontGeometry.getAdvance(nextCharAdvance, character, nextCharacter);
-					advance = nextCharAdvance;
-				}
-				x += fsScale * advance + textParams.Kerning;
-				continue;
+				currentPage = glyph.Page;
+				atlasIndex = (int32_t)FindFontAtlasIndex(font->GetAtlasPage(currentPage));
 			}
 
-			if (character == '\t')
-			{
-				x += 4.0 * (fsScale * spaceGlyphAdvance + textParams.Kerning);
-				continue;
-			}
+			const glm::vec3 minX = axisX * glyph.QuadMin.x;
+			const glm::vec3 maxX = axisX * glyph.QuadMax.x;
+			const glm::vec3 minY = origin + axisY * glyph.QuadMin.y;
+			const glm::vec3 maxY = origin + axisY * glyph.QuadMax.y;
 
-			auto glyph = fontGeometry.getGlyph(character);
-			if (!glyph)
-				glyph = fontGeometry.getGlyph('?');
-			if (!glyph)
-				return;
-
-			double al, ab, ar, at;
-			glyph->getQuadAtlasBounds(al, ab, ar, at);
-			glm::vec2 texCoordMin((float)al, (float)ab);
-			glm::vec2 texCoordMax((float)ar, (float)at);
-
-			double pl, pb, pr, pt;
-			glyph->getQuadPlaneBounds(pl, pb, pr, pt);
-			glm::vec2 quadMin((float)pl, (float)pb);
-			glm::vec2 quadMax((float)pr, (float)pt);
-
-			quadMin *= fsScale;
-			quadMax *= fsScale;
-
-			quadMin += glm::vec2(x, y);
-			quadMax += glm::vec2(x, y);
-
-			const float texelWidth = 1.0f / fontAtlas->GetWidth();
-			const float texelHeight = 1.0f / fontAtlas->GetHeight();
-			texCoordMin *= glm::vec2(texelWidth, texelHeight);
-			texCoordMax *= glm::vec2(texelWidth, texelHeight);
-
-			// Render
-			s_Data->TextVertexBufferPtr->Position = transform * glm::vec4(quadMin, 0.0f, 1.0f);
-			s_Data->TextVertexBufferPtr->Color = textParams.Color;
-			s_Data->TextVertexBufferPtr->TexCoord = texCoordMin;
-			s_Data->TextVertexBufferPtr->EntityId = entityId;
-			s_Data->TextVertexBufferPtr++;
-
-			s_Data->TextVertexBufferPtr->Position = transform * glm::vec4(quadMin.x, quadMax.y, 0.0f, 1.0f);
-			s_Data->TextVertexBufferPtr->Color = textParams.Color;
-			s_Data->TextVertexBufferPtr->TexCoord = { texCoordMin.x, texCoordMax.y };
-			s_Data->TextVertexBufferPtr->EntityId = entityId;
-			s_Data->TextVertexBufferPtr++;
-
-			s_Data->TextVertexBufferPtr->Position = transform * glm::vec4(quadMax, 0.0f, 1.0f);
-			s_Data->TextVertexBufferPtr->Color = textParams.Color;
-			s_Data->TextVertexBufferPtr->TexCoord = texCoordMax;
-			s_Data->TextVertexBufferPtr->EntityId = entityId;
-			s_Data->TextVertexBufferPtr++;
-
-			s_Data->TextVertexBufferPtr->Position = transform * glm::vec4(quadMax.x, quadMin.y, 0.0f, 1.0f);
-			s_Data->TextVertexBufferPtr->Color = textParams.Color;
-			s_Data->TextVertexBufferPtr->TexCoord = { texCoordMax.x, texCoordMin.y };
-			s_Data->TextVertexBufferPtr->EntityId = entityId;
-			s_Data->TextVertexBufferPtr++;
+			TextVertex* vertex = s_Data->TextVertexBufferPtr;
 
-			s_Data->TextIndexCount += 6;
-			s_Data->Stats.QuadCount++;
+			vertex[0].Position = minX + minY;
+			vertex[0].Color = color;
+			vertex[0].TexCoord = glyph.TexCoordMin;
+			vertex[0].AtlasIndex = atlasIndex;
 
-			if (i < string.size() - 1)
-			{
-				double advance = glyph->getAdvance();
-				char nextCharacter = string[i + 1];
-				fontGeometry.getAdvance(advance, character, nextCharacter);
+			vertex[1].Position = minX + maxY;
+			vertex[1].Color = color;
+			vertex[1].TexCoord = { glyph.TexCoordMin.x, glyph.TexCoordMax.y };
+			vertex[1].AtlasIndex = atlasIndex;
 
-				x += fsScale * advance + textParams.Kerning;
-			}
+			vertex[2].Position = maxX + maxY;
+			vertex[2].Color = color;
+			vertex[2].TexCoord = glyph.TexCoordMax;
+			vertex[2].AtlasIndex = atlasIndex;
+
+			vertex[3].Position = maxX + minY;
+			vertex[3].Color = color;
+			vertex[3].TexCoord = { glyph.TexCoordMax.x, glyph.TexCoordMin.y };
+			vertex[3].AtlasIndex = atlasIndex;
+
+			s_Data->TextVertexBufferPtr += 4;
+			s_Data->TextIndexCount += 6;
+
+			WriteEntityIds(s_Data->TextEntityIds, entityId, 4);
 		}
-	}
 
-	void Renderer2D::DrawString(const std::string& string, const glm::mat4& transform, const TextComponent& component, int32_t entityId)
-	{
-		DrawString(string, component.FontAsset, transform, { component.Color, component.Kerning, component.LineSpacing }, entityId);
+		s_Data->Stats.QuadCount += (uint32_t)glyphs.size();
 	}
 
 	float Renderer2D::GetLineWidth()
@@ -718,6 +766,10 @@ namespace Hazel
 
 	uint32_t Renderer2D::FindTextureIndex(const Ref<Texture2D>& texture)
 	{
+		// Textures still loading (or that failed to) are drawn with the white texture in slot 0
+		if (!texture->IsLoaded())
+			return 0;
+
 		uint32_t textureIndex = 0;
 
 		for (uint32_t i = 1; i < s_Data->TextureSlotIndex; i++)
@@ -742,6 +794,22 @@ namespace Hazel
 		return textureIndex;
 	}
 
+	uint32_t Renderer2D::FindFontAtlasIndex(const Ref<Texture2D>& atlas)
+	{
+		for (uint32_t i = 0; i < s_Data->FontAtlasSlotIndex; i++)
+		{
+			if (*s_Data->FontAtlasSlots[i] == *atlas)
+				return i;
+		}
+
+		if (s_Data->FontAtlasSlotIndex >= Renderer2DData::MAX_FONT_ATLAS_SLOTS)
+			NextBatch();
+
+		const uint32_t atlasIndex = s_Data->FontAtlasSlotIndex++;
+		s_Data->FontAtlasSlots[atlasIndex] = atlas;
+		return atlasIndex;
+	}
+
 	void Renderer2D::LoadQuadVertexData(const glm::mat4& transform, const glm::vec4& color, glm::vec2 const* textureCoords, uint32_t textureIndex, float tilingFactor, int32_t entityId)
 	{
 		for (size_t i = 0; i < 4; i++)
@@ -751,10 +819,11 @@ namespace Hazel
 			s_Data->QuadVertexBufferPtr->TexCoord = textureCoords[i];
 			s_Data->QuadVertexBufferPtr->TexIndex = textureIndex;
 			s_Data->QuadVertexBufferPtr->TilingFactor = tilingFactor;
-			s_Data->QuadVertexBufferPtr->EntityId = entityId;
 			s_Data->QuadVertexBufferPtr++;
 		}
 
+		WriteEntityIds(s_Data->QuadEntityIds, entityId, 4);
+
 		s_Data->QuadIndexCount += 6;
 
 		s_Data->Stats.QuadCount++;
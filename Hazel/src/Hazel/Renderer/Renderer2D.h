@@ -4,8 +4,10 @@
 #include "Hazel/Renderer/EditorCamera.h"
 #include "Hazel/Renderer/Font.h"
 #include "Hazel/Renderer/OrthographicCamera.h"
+#include "Hazel/Renderer/Renderer.h"
 #include "Hazel/Renderer/Texture.h"
 #include "Hazel/Renderer/SubTexture2D.h"
+#include "Hazel/Renderer/TextLayout.h"
 
 #include "Hazel/Scene/Components.h"
 
@@ -14,7 +16,7 @@ namespace Hazel
 	class Renderer2D
 	{
 	public:
-		static void Init();
+		static void Init(const RendererConfig& config = {});
 		static void Shutdown();
 		
 		static void BeginScene(const Camera& camera, const glm::mat4& cameraTransform);
@@ -62,6 +64,7 @@ namespace Hazel
 		};
 		static void DrawString(const std::string& string, Ref<Font> font, const glm::mat4& transform, const TextParams& textParams, int32_t entityId = -1);
 		static void DrawString(const std::string& string, const glm::mat4& transform, const TextComponent& component, int32_t entityId = -1);
+		static void DrawString(const TextLayout& layout, const glm::mat4& transform, const glm::vec4& color, int32_t entityId = -1);
 
 		static float GetLineWidth();
 		static void SetLineWidth(float width);
@@ -72,6 +75,8 @@ namespace Hazel
 			uint32_t DrawCalls = 0;
 			uint32_t QuadCount = 0;
 			uint32_t CircleCount = 0;
+			// Vertex data uploaded, entity ids included
+			uint64_t VertexBytes = 0;
 
 			uint32_t GetTotalVertexCount() const { return QuadCount * 4; }
 			uint32_t GetTotalIndexCount() const { return QuadCount * 6; }
@@ -82,6 +87,7 @@ namespace Hazel
 
 	private:
 		static uint32_t FindTextureIndex(const Ref<Texture2D>& texture);
+		static uint32_t FindFontAtlasIndex(const Ref<Texture2D>& atlas);
 		static void LoadQuadVertexData(const glm::mat4& transform, const glm::vec4& color, glm::vec2 const* textureCoords, uint32_t textureIndex, float tilingFactor, int32_t entityId = -1);
 
 		static void StartBatch();
@@ -1,12 +1,15 @@
 #include "hzpch.h"
 #include "Hazel/Renderer/Shader.h"
 
+#include "Hazel/Core/Application.h"
 #include "Hazel/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 
+#include "FileWatch.hpp"
+
 namespace Hazel
 {
-	Ref<Shader> Shader::Create(const FilePath& filepath)
+	Ref<Shader> Shader::Create(const FilePath& filepath, const std::vector<std::string>& defines)
 	{
         switch (Renderer::GetAPI())
         {
@@ -14,7 +17,7 @@ namespace Hazel
                 HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
                 return nullptr;
             case RendererAPI::API::OpenGL:
-                return CreateRef<OpenGLShader>(filepath);
+                return CreateRef<OpenGLShader>(filepath, defines);
         }
 
         HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -36,10 +39,40 @@ namespace Hazel
         return nullptr;
     }
 
+    std::vector<Ref<Shader>> Shader::CreateAll(const std::vector<FilePath>& filepaths, const std::vector<std::string>& defines)
+    {
+        switch (Renderer::GetAPI())
+        {
+            case RendererAPI::API::None:
+                HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+                return {};
+            case RendererAPI::API::OpenGL:
+            {
+                auto shaders = OpenGLShader::CreateAll(filepaths, defines);
+                return { shaders.begin(), shaders.end() };
+            }
+        }
+
+        HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
+        return {};
+    }
+
+    ShaderLibrary::~ShaderLibrary()
+    {
+        // Stops the watcher before the shaders go away, it joins its thread
+        DisableHotReload();
+    }
+
     void ShaderLibrary::Add(const std::string& name, const Ref<Shader>& shader)
     {
         HZ_CORE_ASSERT(!Exists(name), "Shader already exists!");
+
+        std::error_code error;
+        const auto lastWriteTime = shader->GetFilePath().empty() ? std::filesystem::file_time_type() : std::filesystem::last_write_time(shader->GetFilePath(), error);
+
+        std::scoped_lock lock(m_Mutex);
         m_Shaders[name] = shader;
+        m_LastWriteTimes[name] = lastWriteTime;
     }
 	
 	void ShaderLibrary::Add(const Ref<Shader>& shader)
@@ -65,11 +98,79 @@ namespace Hazel
 	Ref<Shader> ShaderLibrary::Get(const std::string& name)
 	{
         HZ_CORE_ASSERT(Exists(name), "Shader not found!");
+
+        std::scoped_lock lock(m_Mutex);
         return m_Shaders[name];
 	}
 
 	bool ShaderLibrary::Exists(const std::string& name) const
 	{
+        std::scoped_lock lock(m_Mutex);
         return m_Shaders.find(name) != m_Shaders.end();
 	}
+
+    void ShaderLibrary::EnableHotReload(const FilePath& directory)
+    {
+        DisableHotReload();
+
+        m_WatchedDirectory = directory;
+        m_FileWatcher = CreateScope<filewatch::FileWatch<std::string>>(directory.string(), [this](const std::string& path, const filewatch::Event changeType)
+        {
+            OnShaderFileSystemEvent(path, changeType);
+        });
+    }
+
+    void ShaderLibrary::DisableHotReload()
+    {
+        m_FileWatcher.reset();
+        m_WatchedDirectory.clear();
+    }
+
+    void ShaderLibrary::OnShaderFileSystemEvent(const std::string& path, filewatch::Event changeType)
+    {
+        // Some editors save by writing a temporary file and renaming it over the original
+        if (changeType != filewatch::Event::modified && changeType != filewatch::Event::added && changeType != filewatch::Event::renamed_new)
+            return;
+
+        const FilePath filepath = m_WatchedDirectory / path;
+
+        std::error_code error;
+        const auto lastWriteTime = std::filesystem::last_write_time(filepath, error);
+        if (error)
+            return;
+
+        Ref<Shader> shader;
+        {
+            std::scoped_lock lock(m_Mutex);
+            for (const auto& [name, candidate] : m_Shaders)
+            {
+                if (candidate->GetFilePath().empty() || !std::filesystem::equivalent(candidate->GetFilePath(), filepath, error))
+                    continue;
+
+                auto& lastHandledWriteTime = m_LastWriteTimes[name];
+                if (lastHandledWriteTime == lastWriteTime)
+                    return;
+
+                lastHandledWriteTime = lastWriteTime;
+                shader = candidate;
+                break;
+            }
+        }
+
+        if (!shader)
+            return;
+
+        HZ_CORE_INFO("Shader source {0} changed, recompiling", filepath);
+        if (!shader->Recompile())
+        {
+            HZ_CORE_ERROR("Shader '{0}' has errors, keeping the previous version", shader->GetName());
+            return;
+        }
+
+        Application::Get().SubmitToMainThread([weakShader = std::weak_ptr<Shader>(shader)]
+        {
+            if (auto shader = weakShader.lock())
+                shader->ApplyRecompiled();
+        });
+    }
 }
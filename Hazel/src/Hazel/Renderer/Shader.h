@@ -4,6 +4,14 @@
 
 #include <glm/glm.hpp>
 
+#include <mutex>
+
+namespace filewatch
+{
+	enum class Event;
+	template<typename T> class FileWatch;
+}
+
 namespace Hazel
 {
 	class Shader
@@ -23,14 +31,31 @@ namespace Hazel
 		virtual void SetMat4(const std::string& name, const glm::mat4& value) = 0;
 		
 		virtual const std::string& GetName() const = 0;
+		// Empty for shaders created from source strings
+		virtual const FilePath& GetFilePath() const = 0;
+
+		// Hot reload is split in two so the compile can run off the render thread.
+		// Recompile builds a new version from the source file without touching the current one, it returns false on errors.
+		virtual bool Recompile() = 0;
+		// Swaps in the version built by the last successful Recompile, call it on the render thread between frames
+		virtual void ApplyRecompiled() = 0;
 		
-		static Ref<Shader> Create(const FilePath& filepath);
+		// Defines are macro names defined in every stage, each set of defines is a separate variant with its own cache entries
+		static Ref<Shader> Create(const FilePath& filepath, const std::vector<std::string>& defines = {});
 		static Ref<Shader> Create(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+		// Compiles the shaders in parallel, the result is in the same order as filepaths
+		static std::vector<Ref<Shader>> CreateAll(const std::vector<FilePath>& filepaths, const std::vector<std::string>& defines = {});
 	};
 
 	class ShaderLibrary
 	{
 	public:
+		ShaderLibrary() = default;
+		~ShaderLibrary();
+
+		ShaderLibrary(const ShaderLibrary&) = delete;
+		ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+
 		void Add(const std::string& name, const Ref<Shader>& shader);
 		void Add(const Ref<Shader>& shader);
 		Ref<Shader> Load(const FilePath& filepath);
@@ -39,7 +64,22 @@ namespace Hazel
 		Ref<Shader> Get(const std::string& name);
 
 		bool Exists(const std::string& name) const;
+
+		// Watches the directory and recompiles a shader on the watcher's thread when its source file changes.
+		// The new program is swapped in at the start of the next frame, a shader with errors keeps its previous program.
+		void EnableHotReload(const FilePath& directory);
+		void DisableHotReload();
+	private:
+		void OnShaderFileSystemEvent(const std::string& path, filewatch::Event changeType);
 	private:
 		std::unordered_map<std::string, Ref<Shader>> m_Shaders;
+
+		// Guards the shaders and the write times against the watcher's thread
+		mutable std::mutex m_Mutex;
+		// Last modification time handled per shader, editors often report a single save as several events
+		std::unordered_map<std::string, std::filesystem::file_time_type> m_LastWriteTimes;
+
+		FilePath m_WatchedDirectory;
+		Scope<filewatch::FileWatch<std::string>> m_FileWatcher;
 	};
 }
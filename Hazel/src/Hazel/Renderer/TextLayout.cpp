@@ -0,0 +1,160 @@
+#include "hzpch.h"
+#include "Hazel/Renderer/TextLayout.h"
+
+namespace Hazel
+{
+	namespace Utils
+	{
+		static constexpr uint32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+		// Malformed sequences decode to U+FFFD one byte at a time, the decoder never reads past the end
+		static void DecodeUTF8(const std::string& string, std::vector<uint32_t>& outCodepoints)
+		{
+			outCodepoints.clear();
+			outCodepoints.reserve(string.size());
+
+			const auto* bytes = (const uint8_t*)string.data();
+			const size_t size = string.size();
+
+			size_t i = 0;
+			while (i < size)
+			{
+				const uint8_t lead = bytes[i];
+				if (lead < 0x80)
+				{
+					outCodepoints.push_back(lead);
+					i++;
+					continue;
+				}
+
+				uint32_t length, codepoint, minimum;
+				if ((lead & 0xE0) == 0xC0)
+				{
+					length = 2; codepoint = lead & 0x1F; minimum = 0x80;
+				}
+				else if ((lead & 0xF0) == 0xE0)
+				{
+					length = 3; codepoint = lead & 0x0F; minimum = 0x800;
+				}
+				else if ((lead & 0xF8) == 0xF0)
+				{
+					length = 4; codepoint = lead & 0x07; minimum = 0x10000;
+				}
+				else
+				{
+					outCodepoints.push_back(REPLACEMENT_CHARACTER);
+					i++;
+					continue;
+				}
+
+				bool valid = i + length <= size;
+				for (uint32_t j = 1; valid && j < length; j++)
+				{
+					const uint8_t continuation = bytes[i + j];
+					valid = (continuation & 0xC0) == 0x80;
+					codepoint = (codepoint << 6) | (continuation & 0x3F);
+				}
+
+				// Overlong encodings, surrogates and anything past the last plane
+				if (!valid || codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+				{
+					outCodepoints.push_back(REPLACEMENT_CHARACTER);
+					i++;
+					continue;
+				}
+
+				outCodepoints.push_back(codepoint);
+				i += length;
+			}
+		}
+	}
+
+	bool TextLayout::Update(const std::string& string, const Ref<Font>& font, float kerning, float lineSpacing)
+	{
+		const uint32_t fontGeneration = font ? font->GetGeneration() : 0;
+		if (font == m_Font && fontGeneration == m_FontGeneration && kerning == m_Kerning && lineSpacing == m_LineSpacing && string == m_String)
+			return false;
+
+		m_String = string;
+		m_Font = font;
+		m_FontGeneration = fontGeneration;
+		m_Kerning = kerning;
+		m_LineSpacing = lineSpacing;
+
+		Build();
+		return true;
+	}
+
+	void TextLayout::Build()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		m_Glyphs.clear();
+
+		// Fonts still loading lay out as nothing, their generation changes once they're ready
+		if (!m_Font || !m_Font->IsLoaded())
+			return;
+
+		const FontGlyph* spaceGlyph = m_Font->GetGlyph(' ');
+		const float spaceGlyphAdvance = spaceGlyph ? spaceGlyph->Advance : 0.0f;
+		const float lineHeight = m_Font->GetLineHeight();
+
+		float x = 0.0f;
+		float y = 0.0f;
+
+		std::vector<uint32_t> codepoints;
+		Utils::DecodeUTF8(m_String, codepoints);
+
+		m_Glyphs.reserve(codepoints.size());
+
+		for (size_t i = 0; i < codepoints.size(); i++)
+		{
+			const uint32_t character = codepoints[i];
+			const uint32_t nextCharacter = i < codepoints.size() - 1 ? codepoints[i + 1] : 0;
+
+			if (character == '\r')
+				continue;
+
+			if (character == '\n')
+			{
+				x = 0.0f;
+				y -= lineHeight + m_LineSpacing;
+				continue;
+			}
+
+			if (character == ' ')
+			{
+				x += spaceGlyphAdvance + m_Font->GetKerning(character, nextCharacter) + m_Kerning;
+				continue;
+			}
+
+			if (character == '\t')
+			{
+				x += 4.0f * (spaceGlyphAdvance + m_Kerning);
+				continue;
+			}
+
+			const FontGlyph* glyph = m_Font->GetGlyph(character);
+			if (!glyph)
+			{
+				m_Font->RequestGlyph(character);
+				glyph = m_Font->GetGlyph('?');
+			}
+			if (!glyph)
+				return;
+
+			// Whitespace outside of the cases above has an advance but nothing to draw
+			if (glyph->QuadMax.x > glyph->QuadMin.x && glyph->QuadMax.y > glyph->QuadMin.y)
+			{
+				Glyph& quad = m_Glyphs.emplace_back();
+				quad.QuadMin = glyph->QuadMin + glm::vec2(x, y);
+				quad.QuadMax = glyph->QuadMax + glm::vec2(x, y);
+				quad.TexCoordMin = glyph->TexCoordMin;
+				quad.TexCoordMax = glyph->TexCoordMax;
+				quad.Page = glyph->Page;
+			}
+
+			x += glyph->Advance + m_Font->GetKerning(character, nextCharacter) + m_Kerning;
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Hazel/Renderer/Font.h"
+
+#include <glm/glm.hpp>
+
+namespace Hazel
+{
+	// A UTF-8 string laid out with a font, as one quad per glyph in the text's local space.
+	// Update only lays the string out again when one of its inputs changed, so static text
+	// costs a transform and a copy per glyph when it's drawn.
+	// Glyphs the font doesn't have yet are requested and drawn as '?' until they are generated,
+	// the font's generation changing is what makes the layout pick them up.
+	class TextLayout
+	{
+	public:
+		struct Glyph
+		{
+			glm::vec2 QuadMin, QuadMax;
+			glm::vec2 TexCoordMin, TexCoordMax;
+			// Font atlas page
+			uint32_t Page = 0;
+		};
+
+		// Returns true if the layout had to be rebuilt
+		bool Update(const std::string& string, const Ref<Font>& font, float kerning, float lineSpacing);
+
+		const Ref<Font>& GetFont() const { return m_Font; }
+		const std::vector<Glyph>& GetGlyphs() const { return m_Glyphs; }
+	private:
+		void Build();
+	private:
+		std::string m_String;
+		Ref<Font> m_Font;
+		uint32_t m_FontGeneration = 0;
+		float m_Kerning = 0.0f;
+		float m_LineSpacing = 0.0f;
+
+		std::vector<Glyph> m_Glyphs;
+	};
+}
@@ -2,6 +2,7 @@
 #include "Hazel/Renderer/Texture.h"
 
 #include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/TextureLoader.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
 
 namespace Hazel
@@ -35,4 +36,22 @@ namespace Hazel
         HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
         return nullptr;
 	}
+
+	Ref<Texture2D> Texture2D::CreateAsync(const FilePath& path)
+	{
+		Ref<Texture2D> texture;
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:
+				HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+				return nullptr;
+			case RendererAPI::API::OpenGL:
+				texture = CreateRef<OpenGLTexture2D>(path, true);
+				break;
+		}
+
+		HZ_CORE_ASSERT(texture, "Unknown RendererAPI!");
+		TextureLoader::LoadAsync(texture);
+		return texture;
+	}
 }
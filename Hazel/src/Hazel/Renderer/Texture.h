@@ -14,6 +14,11 @@ namespace Hazel
 		RGBA32F
 	};
 
+	enum class TextureLoadState
+	{
+		Loading = 0, Loaded, Failed
+	};
+
 	struct TextureSpecification
 	{
 		uint32_t Width = 1;
@@ -36,10 +41,13 @@ namespace Hazel
 		virtual const FilePath& GetPath() const = 0;
 
 		virtual void SetData(void* data, uint32_t size) = 0;
+		// Tightly packed pixels for the region, in the texture's format
+		virtual void SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
 		
 		virtual void Bind(uint32_t slot = 0) const = 0;
 
-		virtual bool IsLoaded() const = 0;
+		virtual TextureLoadState GetLoadState() const = 0;
+		bool IsLoaded() const { return GetLoadState() == TextureLoadState::Loaded; }
 
 		virtual bool operator==(const Texture& other) const = 0;
 	};
@@ -49,5 +57,12 @@ namespace Hazel
 	public:
 		static Ref<Texture2D> Create(const TextureSpecification& specification);
 		static Ref<Texture2D> Create(const FilePath& path);
+		// Returns right away, the image is decoded on a worker thread and uploaded by TextureLoader::ProcessUploads.
+		// Renderer2D draws it with the white texture until then
+		static Ref<Texture2D> CreateAsync(const FilePath& path);
+
+		// Replaces the texture's storage with the given image, nullptr marks the load as failed.
+		// With more than one mip the levels are tightly packed, largest first
+		virtual void Upload(const TextureSpecification& specification, const void* data, uint32_t mipCount = 1) = 0;
 	};
 }
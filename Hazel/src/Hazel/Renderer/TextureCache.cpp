@@ -0,0 +1,271 @@
+#include "hzpch.h"
+#include "Hazel/Renderer/TextureCache.h"
+
+#include "Hazel/Core/Hash.h"
+#include "Hazel/Core/Timer.h"
+
+#include <stb_image.h>
+
+#include <fstream>
+#include <thread>
+
+namespace Hazel
+{
+	constexpr uint32_t TEXTURE_CACHE_MAGIC = 'H' | ('Z' << 8) | ('T' << 16) | ('X' << 24);
+	constexpr uint32_t TEXTURE_CACHE_VERSION = 1;
+
+	// Followed by the mip chain, see TextureImage
+	struct TextureCacheHeader
+	{
+		uint32_t Magic = TEXTURE_CACHE_MAGIC;
+		uint32_t Version = TEXTURE_CACHE_VERSION;
+		uint64_t SourceHash = 0;
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		uint32_t Format = 0;
+		uint32_t MipCount = 0;
+		uint64_t DataSize = 0;
+	};
+
+	namespace Utils
+	{
+		static uint32_t GetBytesPerPixel(ImageFormat format)
+		{
+			switch (format)
+			{
+				case ImageFormat::RGB8:  return 3;
+				case ImageFormat::RGBA8: return 4;
+			}
+
+			HZ_CORE_ASSERT(false, "Unsupported cached texture format");
+			return 0;
+		}
+
+		static uint32_t GetMipCount(uint32_t width, uint32_t height)
+		{
+			uint32_t mipCount = 1;
+			while (width > 1 || height > 1)
+			{
+				width = std::max(width / 2, 1u);
+				height = std::max(height / 2, 1u);
+				mipCount++;
+			}
+			return mipCount;
+		}
+
+		static uint64_t GetMipChainSize(uint32_t width, uint32_t height, uint32_t mipCount, uint32_t bytesPerPixel)
+		{
+			uint64_t size = 0;
+			for (uint32_t i = 0; i < mipCount; i++)
+			{
+				size += (uint64_t)width * height * bytesPerPixel;
+				width = std::max(width / 2, 1u);
+				height = std::max(height / 2, 1u);
+			}
+			return size;
+		}
+
+		// 2x2 box filter, odd edges reuse the last row/column
+		static void DownsampleMip(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight, uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight, uint32_t bytesPerPixel)
+		{
+			for (uint32_t y = 0; y < dstHeight; y++)
+			{
+				const uint32_t y0 = std::min(y * 2, srcHeight - 1);
+				const uint32_t y1 = std::min(y * 2 + 1, srcHeight - 1);
+
+				for (uint32_t x = 0; x < dstWidth; x++)
+				{
+					const uint32_t x0 = std::min(x * 2, srcWidth - 1);
+					const uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1);
+
+					for (uint32_t c = 0; c < bytesPerPixel; c++)
+					{
+						const uint32_t sum = src[(y0 * srcWidth + x0) * bytesPerPixel + c] + src[(y0 * srcWidth + x1) * bytesPerPixel + c]
+							+ src[(y1 * srcWidth + x0) * bytesPerPixel + c] + src[(y1 * srcWidth + x1) * bytesPerPixel + c];
+						dst[(y * dstWidth + x) * bytesPerPixel + c] = (uint8_t)((sum + 2) / 4);
+					}
+				}
+			}
+		}
+
+		static FilePath GetCachePath(uint64_t sourceHash)
+		{
+			return TextureCache::GetCacheDirectory() / fmt::format("{:016x}.hztex", sourceHash);
+		}
+
+		static bool LoadFromCache(uint64_t sourceHash, TextureImage& outImage)
+		{
+			auto file = CreateRef<MappedFile>(GetCachePath(sourceHash));
+			if (!*file || file->Size() < sizeof(TextureCacheHeader))
+				return false;
+
+			const auto* header = file->As<TextureCacheHeader>();
+			if (header->Magic != TEXTURE_CACHE_MAGIC || header->Version != TEXTURE_CACHE_VERSION || header->SourceHash != sourceHash)
+				return false;
+
+			const auto format = (ImageFormat)header->Format;
+			if ((format != ImageFormat::RGB8 && format != ImageFormat::RGBA8)
+				|| header->DataSize != GetMipChainSize(header->Width, header->Height, header->MipCount, GetBytesPerPixel(format))
+				|| sizeof(TextureCacheHeader) + header->DataSize > file->Size())
+			{
+				return false;
+			}
+
+			outImage.Specification.Width = header->Width;
+			outImage.Specification.Height = header->Height;
+			outImage.Specification.Format = format;
+			outImage.Specification.GenerateMips = header->MipCount > 1;
+			outImage.MipCount = header->MipCount;
+			outImage.Data = file->Data() + sizeof(TextureCacheHeader);
+			outImage.Size = header->DataSize;
+
+			// Fault the pages in here rather than during the upload on the main thread
+			volatile uint8_t touch = 0;
+			for (uint64_t offset = 0; offset < outImage.Size; offset += 4096)
+				touch += outImage.Data[offset];
+
+			outImage.Storage = file;
+			return true;
+		}
+
+		static void StoreInCache(uint64_t sourceHash, const TextureImage& image)
+		{
+			TextureCacheHeader header;
+			header.SourceHash = sourceHash;
+			header.Width = image.Specification.Width;
+			header.Height = image.Specification.Height;
+			header.Format = (uint32_t)image.Specification.Format;
+			header.MipCount = image.MipCount;
+			header.DataSize = image.Size;
+
+			std::error_code error;
+			std::filesystem::create_directories(TextureCache::GetCacheDirectory(), error);
+
+			// Written under a unique name first so a reader never maps a half written entry
+			const FilePath cachePath = GetCachePath(sourceHash);
+			FilePath tempPath = cachePath;
+			tempPath += fmt::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+			{
+				std::ofstream out(tempPath, std::ios::out | std::ios::binary);
+				if (!out)
+				{
+					HZ_CORE_WARN("Could not write texture cache entry {0}", cachePath);
+					return;
+				}
+
+				out.write((const char*)&header, sizeof(TextureCacheHeader));
+				out.write((const char*)image.Data, (std::streamsize)image.Size);
+			}
+
+			// Fails if another thread stored the same entry and it's mapped, which is fine
+			std::filesystem::rename(tempPath, cachePath, error);
+			if (error)
+				std::filesystem::remove(tempPath, error);
+		}
+
+		static bool DecodeImage(const MappedFile& source, TextureImage& outImage)
+		{
+			HZ_PROFILE_FUNCTION();
+
+			int32_t width, height, channels;
+			if (!stbi_info_from_memory(source.Data(), (int32_t)source.Size(), &width, &height, &channels))
+				return false;
+
+			// Anything that isn't RGB is expanded to RGBA
+			const int32_t desiredChannels = channels == 3 ? 3 : 4;
+
+			stbi_set_flip_vertically_on_load_thread(1);
+			stbi_uc* pixels = stbi_load_from_memory(source.Data(), (int32_t)source.Size(), &width, &height, &channels, desiredChannels);
+			if (!pixels)
+				return false;
+
+			const uint32_t mipCount = GetMipCount(width, height);
+			const uint64_t size = GetMipChainSize(width, height, mipCount, desiredChannels);
+			Ref<uint8_t> mipChain(new uint8_t[size], std::default_delete<uint8_t[]>());
+
+			const uint64_t baseSize = (uint64_t)width * height * desiredChannels;
+			memcpy(mipChain.get(), pixels, baseSize);
+			stbi_image_free(pixels);
+
+			uint8_t* src = mipChain.get();
+			uint32_t srcWidth = width, srcHeight = height;
+			for (uint32_t i = 1; i < mipCount; i++)
+			{
+				const uint32_t dstWidth = std::max(srcWidth / 2, 1u);
+				const uint32_t dstHeight = std::max(srcHeight / 2, 1u);
+				uint8_t* dst = src + (uint64_t)srcWidth * srcHeight * desiredChannels;
+
+				DownsampleMip(src, srcWidth, srcHeight, dst, dstWidth, dstHeight, desiredChannels);
+
+				src = dst;
+				srcWidth = dstWidth;
+				srcHeight = dstHeight;
+			}
+
+			outImage.Specification.Width = width;
+			outImage.Specification.Height = height;
+			outImage.Specification.Format = desiredChannels == 3 ? ImageFormat::RGB8 : ImageFormat::RGBA8;
+			outImage.Specification.GenerateMips = mipCount > 1;
+			outImage.MipCount = mipCount;
+			outImage.Data = mipChain.get();
+			outImage.Size = size;
+			outImage.Storage = mipChain;
+			return true;
+		}
+	}
+
+	FilePath TextureCache::GetCacheDirectory()
+	{
+		return "assets/cache/texture";
+	}
+
+	bool TextureCache::Import(const FilePath& path, TextureImage& outImage)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		uint64_t sourceHash;
+		{
+			const MappedFile source(path);
+			if (!source)
+				return false;
+
+			sourceHash = Hash::FNV1a(source.Data(), source.Size());
+			if (Utils::LoadFromCache(sourceHash, outImage))
+				return true;
+
+			if (!Utils::DecodeImage(source, outImage))
+				return false;
+		}
+
+		Utils::StoreInCache(sourceHash, outImage);
+		return true;
+	}
+
+	uint32_t TextureCache::ImportDirectory(const FilePath& directory)
+	{
+		Timer timer;
+
+		uint32_t imported = 0;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+		{
+			if (!entry.is_regular_file() || !IsImageFile(entry.path()))
+				continue;
+
+			TextureImage image;
+			if (Import(entry.path(), image))
+				imported++;
+			else
+				HZ_CORE_WARN("Could not import texture {0}", entry.path());
+		}
+
+		HZ_CORE_INFO("Imported {0} textures from {1} in {2:.2f}ms", imported, directory, timer.ElapsedMillis());
+		return imported;
+	}
+
+	bool TextureCache::IsImageFile(const FilePath& path)
+	{
+		const std::string extension = path.extension().string();
+		return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp";
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Hazel/Core/FileSystem.h"
+#include "Hazel/Renderer/Texture.h"
+
+namespace Hazel
+{
+	// Pixels ready to upload, with every mip level tightly packed largest first
+	struct TextureImage
+	{
+		TextureSpecification Specification;
+		uint32_t MipCount = 1;
+		const uint8_t* Data = nullptr;
+		uint64_t Size = 0;
+
+		// Keeps Data alive, either the decoded pixels or the mapped cache file
+		Ref<void> Storage;
+	};
+
+	// Processed images stored next to the shader cache, keyed by a hash of the source file's bytes.
+	// Entries are flipped for OpenGL and carry their full mip chain, so loading one is a file mapping
+	// instead of a PNG decode plus driver mip generation. Stale entries are never hit since editing
+	// the source changes its hash.
+	class TextureCache
+	{
+	public:
+		static FilePath GetCacheDirectory();
+
+		// Returns the cached image for the source file, decoding it and adding it to the cache on a miss. Thread safe
+		static bool Import(const FilePath& path, TextureImage& outImage);
+		// Imports every image file under the directory, returns how many were processed
+		static uint32_t ImportDirectory(const FilePath& directory);
+
+		static bool IsImageFile(const FilePath& path);
+	};
+}
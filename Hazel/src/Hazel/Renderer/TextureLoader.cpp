@@ -0,0 +1,102 @@
+#include "hzpch.h"
+#include "Hazel/Renderer/TextureLoader.h"
+
+#include "Hazel/Core/ThreadPool.h"
+#include "Hazel/Renderer/TextureCache.h"
+
+#include <atomic>
+
+namespace Hazel
+{
+	struct PendingUpload
+	{
+		std::weak_ptr<Texture2D> Texture;
+		TextureImage Image;
+	};
+
+	struct TextureLoaderData
+	{
+		Scope<ThreadPool> Workers;
+
+		std::deque<PendingUpload> Uploads;
+		std::mutex UploadsMutex;
+
+		std::atomic<uint32_t> PendingCount = 0;
+		uint64_t UploadBudget = 16 * 1024 * 1024;
+	};
+
+	static TextureLoaderData* s_Data = nullptr;
+
+	void TextureLoader::Init()
+	{
+		s_Data = new TextureLoaderData();
+		s_Data->Workers = CreateScope<ThreadPool>();
+	}
+
+	void TextureLoader::Shutdown()
+	{
+		// Stop the workers first so nothing is queued while the remaining images are freed
+		s_Data->Workers = nullptr;
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	void TextureLoader::LoadAsync(const Ref<Texture2D>& texture)
+	{
+		s_Data->PendingCount++;
+
+		// Only a weak reference is kept, textures dropped while loading are skipped
+		s_Data->Workers->Submit([weakTexture = std::weak_ptr<Texture2D>(texture), path = texture->GetPath()]
+		{
+			PendingUpload upload;
+			upload.Texture = weakTexture;
+
+			if (!weakTexture.expired() && !TextureCache::Import(path, upload.Image))
+				HZ_CORE_WARN("Could not load texture {0}", path);
+
+			std::scoped_lock lock(s_Data->UploadsMutex);
+			s_Data->Uploads.push_back(std::move(upload));
+		});
+	}
+
+	void TextureLoader::ProcessUploads()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		uint64_t uploadedBytes = 0;
+		while (uploadedBytes < s_Data->UploadBudget)
+		{
+			PendingUpload upload;
+			{
+				std::scoped_lock lock(s_Data->UploadsMutex);
+				if (s_Data->Uploads.empty())
+					break;
+
+				upload = std::move(s_Data->Uploads.front());
+				s_Data->Uploads.pop_front();
+			}
+
+			if (auto texture = upload.Texture.lock())
+				texture->Upload(upload.Image.Specification, upload.Image.Data, upload.Image.MipCount);
+
+			uploadedBytes += upload.Image.Size;
+			s_Data->PendingCount--;
+		}
+	}
+
+	void TextureLoader::SetUploadBudget(uint64_t bytesPerFrame)
+	{
+		s_Data->UploadBudget = bytesPerFrame;
+	}
+
+	uint64_t TextureLoader::GetUploadBudget()
+	{
+		return s_Data->UploadBudget;
+	}
+
+	uint32_t TextureLoader::GetPendingCount()
+	{
+		return s_Data->PendingCount;
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Hazel/Renderer/Texture.h"
+
+namespace Hazel
+{
+	// Loads image files through the TextureCache on a thread pool and uploads them on the main thread.
+	// Uploads are spread over frames, each frame uploads images until the byte budget is spent (always at least one)
+	class TextureLoader
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		static void LoadAsync(const Ref<Texture2D>& texture);
+
+		// Called once per frame by the Application
+		static void ProcessUploads();
+
+		static void SetUploadBudget(uint64_t bytesPerFrame);
+		static uint64_t GetUploadBudget();
+		// Images waiting to be loaded or uploaded
+		static uint32_t GetPendingCount();
+	};
+}
@@ -0,0 +1,181 @@
+#include "hzpch.h"
+#include "Hazel/Renderer/ThumbnailCache.h"
+
+#include "Hazel/Core/Hash.h"
+
+#include <fstream>
+#include <thread>
+
+namespace Hazel
+{
+	constexpr uint32_t THUMBNAIL_CACHE_MAGIC = 'H' | ('Z' << 8) | ('T' << 16) | ('H' << 24);
+	constexpr uint32_t THUMBNAIL_CACHE_VERSION = 1;
+
+	// Followed by the pixels of a single level
+	struct ThumbnailCacheHeader
+	{
+		uint32_t Magic = THUMBNAIL_CACHE_MAGIC;
+		uint32_t Version = THUMBNAIL_CACHE_VERSION;
+		uint64_t Key = 0;
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		uint32_t Format = 0;
+		uint64_t DataSize = 0;
+	};
+
+	namespace Utils
+	{
+		static uint32_t GetBytesPerPixel(ImageFormat format)
+		{
+			switch (format)
+			{
+				case ImageFormat::RGB8:  return 3;
+				case ImageFormat::RGBA8: return 4;
+			}
+
+			return 0;
+		}
+
+		static bool GetThumbnailKey(const FilePath& path, uint32_t maxSize, uint64_t& outKey)
+		{
+			std::error_code error;
+			const uint64_t fileSize = std::filesystem::file_size(path, error);
+			if (error)
+				return false;
+
+			const auto lastWriteTime = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+			if (error)
+				return false;
+
+			const FilePath absolutePath = std::filesystem::absolute(path, error);
+			outKey = Hash::FNV1a(absolutePath.generic_string());
+			outKey = Hash::FNV1a(&fileSize, sizeof(fileSize), outKey);
+			outKey = Hash::FNV1a(&lastWriteTime, sizeof(lastWriteTime), outKey);
+			outKey = Hash::FNV1a(&maxSize, sizeof(maxSize), outKey);
+			return true;
+		}
+
+		static FilePath GetThumbnailCachePath(uint64_t key)
+		{
+			return ThumbnailCache::GetCacheDirectory() / fmt::format("{:016x}.hzthumb", key);
+		}
+
+		static bool LoadThumbnailFromCache(uint64_t key, TextureImage& outImage)
+		{
+			auto file = CreateRef<MappedFile>(GetThumbnailCachePath(key));
+			if (!*file || file->Size() < sizeof(ThumbnailCacheHeader))
+				return false;
+
+			const auto* header = file->As<ThumbnailCacheHeader>();
+			if (header->Magic != THUMBNAIL_CACHE_MAGIC || header->Version != THUMBNAIL_CACHE_VERSION || header->Key != key)
+				return false;
+
+			const auto format = (ImageFormat)header->Format;
+			const uint32_t bytesPerPixel = GetBytesPerPixel(format);
+			if (bytesPerPixel == 0
+				|| header->DataSize != (uint64_t)header->Width * header->Height * bytesPerPixel
+				|| sizeof(ThumbnailCacheHeader) + header->DataSize > file->Size())
+			{
+				return false;
+			}
+
+			outImage.Specification.Width = header->Width;
+			outImage.Specification.Height = header->Height;
+			outImage.Specification.Format = format;
+			outImage.Specification.GenerateMips = false;
+			outImage.MipCount = 1;
+			outImage.Data = file->Data() + sizeof(ThumbnailCacheHeader);
+			outImage.Size = header->DataSize;
+			outImage.Storage = file;
+			return true;
+		}
+
+		static void StoreThumbnailInCache(uint64_t key, const TextureImage& image)
+		{
+			ThumbnailCacheHeader header;
+			header.Key = key;
+			header.Width = image.Specification.Width;
+			header.Height = image.Specification.Height;
+			header.Format = (uint32_t)image.Specification.Format;
+			header.DataSize = image.Size;
+
+			std::error_code error;
+			std::filesystem::create_directories(ThumbnailCache::GetCacheDirectory(), error);
+
+			// Same as the texture cache, a reader never maps a half written entry
+			const FilePath cachePath = GetThumbnailCachePath(key);
+			FilePath tempPath = cachePath;
+			tempPath += fmt::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+			{
+				std::ofstream out(tempPath, std::ios::out | std::ios::binary);
+				if (!out)
+				{
+					HZ_CORE_WARN("Could not write thumbnail cache entry {0}", cachePath);
+					return;
+				}
+
+				out.write((const char*)&header, sizeof(ThumbnailCacheHeader));
+				out.write((const char*)image.Data, (std::streamsize)image.Size);
+			}
+
+			std::filesystem::rename(tempPath, cachePath, error);
+			if (error)
+				std::filesystem::remove(tempPath, error);
+		}
+
+		// Copies out the largest mip of the chain that fits in maxSize, the smallest one if none does
+		static void ExtractThumbnail(const TextureImage& image, uint32_t maxSize, TextureImage& outImage)
+		{
+			const uint32_t bytesPerPixel = GetBytesPerPixel(image.Specification.Format);
+
+			uint32_t width = image.Specification.Width;
+			uint32_t height = image.Specification.Height;
+			uint64_t offset = 0;
+			for (uint32_t mip = 1; mip < image.MipCount && (width > maxSize || height > maxSize); mip++)
+			{
+				offset += (uint64_t)width * height * bytesPerPixel;
+				width = std::max(width / 2, 1u);
+				height = std::max(height / 2, 1u);
+			}
+
+			const uint64_t size = (uint64_t)width * height * bytesPerPixel;
+			Ref<uint8_t> pixels(new uint8_t[size], std::default_delete<uint8_t[]>());
+			memcpy(pixels.get(), image.Data + offset, size);
+
+			outImage.Specification.Width = width;
+			outImage.Specification.Height = height;
+			outImage.Specification.Format = image.Specification.Format;
+			outImage.Specification.GenerateMips = false;
+			outImage.MipCount = 1;
+			outImage.Data = pixels.get();
+			outImage.Size = size;
+			outImage.Storage = pixels;
+		}
+	}
+
+	FilePath ThumbnailCache::GetCacheDirectory()
+	{
+		return "assets/cache/thumbnail";
+	}
+
+	bool ThumbnailCache::Load(const FilePath& path, uint32_t maxSize, TextureImage& outImage)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		uint64_t key;
+		if (!Utils::GetThumbnailKey(path, maxSize, key))
+			return false;
+
+		if (Utils::LoadThumbnailFromCache(key, outImage))
+			return true;
+
+		TextureImage image;
+		if (!TextureCache::Import(path, image) || Utils::GetBytesPerPixel(image.Specification.Format) == 0)
+			return false;
+
+		Utils::ExtractThumbnail(image, maxSize, outImage);
+		Utils::StoreThumbnailInCache(key, outImage);
+		return true;
+	}
+}
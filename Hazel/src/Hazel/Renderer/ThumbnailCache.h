@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Hazel/Core/FileSystem.h"
+#include "Hazel/Renderer/TextureCache.h"
+
+namespace Hazel
+{
+	// Downscaled previews of image files for the editor, stored next to the texture cache.
+	// Entries are keyed by the source's path, size and last write time, so finding one doesn't read the source.
+	// A miss goes through the TextureCache and keeps the first mip that fits, no image is resampled twice.
+	class ThumbnailCache
+	{
+	public:
+		static FilePath GetCacheDirectory();
+
+		// Returns a single level image no larger than maxSize on either side, generating it on a miss. Thread safe
+		static bool Load(const FilePath& path, uint32_t maxSize, TextureImage& outImage);
+	};
+}
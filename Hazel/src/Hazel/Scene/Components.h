@@ -1,10 +1,12 @@
 #pragma once
 
+#include "Hazel/Asset/Asset.h"
 #include "Hazel/Core/UUID.h"
 
 #include "Hazel/Scene/SceneCamera.h"
 
 #include "Hazel/Renderer/Font.h"
+#include "Hazel/Renderer/TextLayout.h"
 #include "Hazel/Renderer/Texture.h"
 
 #include <glm/glm.hpp>
@@ -59,7 +61,8 @@ namespace Hazel
 	struct SpriteRendererComponent
 	{
 		glm::vec4 Color{ 1.0f, 1.0f, 1.0f, 1.0f };
-		Ref<Texture2D> Texture;
+		// Change it through Entity::PatchComponent so the scene keeps the asset's reference count right
+		AssetHandle Texture = 0;
 		float TilingFactor = 1.0f;
 
 		SpriteRendererComponent() = default;
@@ -170,6 +173,9 @@ namespace Hazel
 		float Kerning = 0.0f;
 		float LineSpacing = 0.0f;
 		glm::vec4 Color{ 1.0f };
+
+		// Render cache, rebuilt by Renderer2D::DrawString whenever the fields above no longer match it
+		mutable TextLayout Layout;
 	};
 
 	template<typename ... Component>
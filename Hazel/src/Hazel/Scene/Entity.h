@@ -27,6 +27,14 @@ namespace Hazel
 			return m_Scene->m_Registry.emplace_or_replace<T>(m_EntityHandle, std::forward<Args>(args)...);
 		}
 
+		// Modifies the component in place and notifies on_update listeners
+		template<typename T, typename Func>
+		T& PatchComponent(Func&& func)
+		{
+			HZ_CORE_ASSERT(HasComponent<T>(), "Entity does not have component!");
+			return m_Scene->m_Registry.patch<T>(m_EntityHandle, std::forward<Func>(func));
+		}
+
 		template<typename T>
 		T& GetComponent()
 		{
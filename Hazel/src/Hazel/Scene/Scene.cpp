@@ -1,6 +1,8 @@
 #include "hzpch.h"
 #include "Hazel/Scene/Scene.h"
 
+#include "Hazel/Asset/AssetManager.h"
+
 #include "Hazel/Scene/Entity.h"
 #include "Hazel/Scene/ScriptableEntity.h"
 #include "Hazel/Scene/Components.h"
@@ -19,23 +21,25 @@
 
 namespace Hazel
 {
+	// Both registries must have the same entities, each pool is copied in one pass into storage reserved up front
 	template<typename ... Component>
-	static void CopyComponent(entt::registry& dst, entt::registry& src, const std::unordered_map<UUID, EntityId>& enttMap)
+	static void CopyComponentStorage(entt::registry& dst, const entt::registry& src)
 	{
 		([&]()
 			{
-				src.view<Component>().each([&](EntityId srcEntity, Component& srcComponent)
+				const auto view = src.view<const Component>();
+				dst.reserve<Component>(view.size());
+				view.each([&](EntityId entity, const Component& component)
 				{
-					EntityId dstEntity = enttMap.at(src.get<IdComponent>(srcEntity).Id);
-					dst.emplace_or_replace<Component>(dstEntity, srcComponent);
+					dst.emplace<Component>(entity, component);
 				});
 			}(), ...);
 	}
 
 	template<typename ... Component>
-	static void CopyComponent(ComponentGroup<Component...>, entt::registry& dst, entt::registry& src, const std::unordered_map<UUID, EntityId>& enttMap)
+	static void CopyComponentStorage(ComponentGroup<Component...>, entt::registry& dst, const entt::registry& src)
 	{
-		CopyComponent<Component...>(dst, src, enttMap);
+		CopyComponentStorage<Component...>(dst, src);
 	}
 
 	template<typename ... Component>
@@ -54,9 +58,9 @@ namespace Hazel
 		CopyComponentIfExists<Component...>(dst, src);
 	}
 
-	static void CopyAllComponents(entt::registry& dst, entt::registry& src, const std::unordered_map<UUID, EntityId>& enttMap)
+	static void CopyAllComponentStorages(entt::registry& dst, const entt::registry& src)
 	{
-		CopyComponent(AllComponents{}, dst, src, enttMap);
+		CopyComponentStorage(AllComponents{}, dst, src);
 	}
 
 	static void CopyAllExistingComponents(Entity dst, Entity src)
@@ -68,36 +72,66 @@ namespace Hazel
 	{
 		m_Registry.on_construct<CameraComponent>().connect<&Scene::OnCameraComponentAdded>(this);
 		m_Registry.on_construct<NativeScriptComponent>().connect<&Scene::OnNativeScriptComponentAdded>(this);
+
+		m_Registry.on_construct<TagComponent>().connect<&Scene::OnTagComponentAdded>(this);
+		m_Registry.on_update<TagComponent>().connect<&Scene::OnTagComponentUpdated>(this);
+		m_Registry.on_destroy<TagComponent>().connect<&Scene::OnTagComponentRemoved>(this);
+
+		m_Registry.on_construct<SpriteRendererComponent>().connect<&Scene::OnSpriteRendererComponentAdded>(this);
+		m_Registry.on_update<SpriteRendererComponent>().connect<&Scene::OnSpriteRendererComponentUpdated>(this);
+		m_Registry.on_destroy<SpriteRendererComponent>().connect<&Scene::OnSpriteRendererComponentRemoved>(this);
 	}
 
 	Scene::~Scene()
 	{
-		m_Registry.on_destroy<CameraComponent>().disconnect();
-		m_Registry.on_destroy<NativeScriptComponent>().disconnect();
+		m_Registry.on_construct<CameraComponent>().disconnect(this);
+		m_Registry.on_construct<NativeScriptComponent>().disconnect(this);
+
+		m_Registry.on_construct<TagComponent>().disconnect(this);
+		m_Registry.on_update<TagComponent>().disconnect(this);
+		m_Registry.on_destroy<TagComponent>().disconnect(this);
+
+		m_Registry.on_construct<SpriteRendererComponent>().disconnect(this);
+		m_Registry.on_update<SpriteRendererComponent>().disconnect(this);
+		m_Registry.on_destroy<SpriteRendererComponent>().disconnect(this);
+
+		// The registry doesn't emit on_destroy when it's destroyed
+		for (const auto& [entity, texture] : m_SpriteTextures)
+			AssetManager::Release(texture);
+
 		delete m_PhysicsWorld;
 	}
 
 	Ref<Scene> Scene::Copy(const Ref<Scene>& scene)
 	{
+		HZ_PROFILE_FUNCTION();
+
 		auto newScene = CreateRef<Scene>();
 
 		newScene->m_ViewportWidth = scene->m_ViewportWidth;
 		newScene->m_ViewportHeight = scene->m_ViewportHeight;
 
-		std::unordered_map<UUID, EntityId> enttMap;
-
-		// Create entities in the new scene
 		auto& srcSceneRegistry = scene->m_Registry;
 		auto& dstSceneRegistry = newScene->m_Registry;
 
-		srcSceneRegistry.group<IdComponent, TagComponent>().each([&](const IdComponent& idComponent, const TagComponent& tagComponent)
-		{
-			auto uuid = idComponent.Id;
-			Entity newEntity = newScene->CreateEntityWithUuid(uuid, tagComponent.Tag);
-			enttMap[uuid] = newEntity;
-		});
+		// The entity list is cloned as is, destroyed slots included, so every entity keeps its id in the copy.
+		// That way the components don't have to be matched by UUID and the maps keyed by entity stay valid
+		dstSceneRegistry.assign(srcSceneRegistry.data(), srcSceneRegistry.data() + srcSceneRegistry.size(), srcSceneRegistry.released());
+		newScene->m_EntityMap = scene->m_EntityMap;
+
+		// The name indices are copied whole rather than rebuilt by the signal one tag at a time
+		dstSceneRegistry.on_construct<TagComponent>().disconnect<&Scene::OnTagComponentAdded>(newScene.get());
+		CopyComponentStorage<IdComponent, TagComponent>(dstSceneRegistry, srcSceneRegistry);
+		dstSceneRegistry.on_construct<TagComponent>().connect<&Scene::OnTagComponentAdded>(newScene.get());
 
-		CopyAllComponents(dstSceneRegistry, srcSceneRegistry, enttMap);
+		newScene->m_EntityNameIndex = scene->m_EntityNameIndex;
+		newScene->m_SortedEntityNames = scene->m_SortedEntityNames;
+		newScene->m_EntityNameEntries.reserve(newScene->m_SortedEntityNames.size());
+		for (auto it = newScene->m_SortedEntityNames.begin(); it != newScene->m_SortedEntityNames.end(); ++it)
+			newScene->m_EntityNameEntries[it->second] = it;
+
+		// The remaining signals still run, sprites have to acquire their textures in the new scene
+		CopyAllComponentStorages(dstSceneRegistry, srcSceneRegistry);
 
 		return newScene;
 	}
@@ -112,8 +146,7 @@ namespace Hazel
 		Entity entity{ m_Registry.create(), this };
 		entity.AddComponent<IdComponent>(uuid);
 		entity.AddComponent<TransformComponent>();
-		auto& tag = entity.AddComponent<TagComponent>();
-		tag.Tag = name.empty() ? "Entity" : name;
+		entity.AddComponent<TagComponent>(name.empty() ? "Entity" : name);
 		m_EntityMap[uuid] = entity;
 		return entity;
 	}
@@ -125,9 +158,19 @@ namespace Hazel
 		return newEntity;
 	}
 
+	Entity Scene::ImportEntity(Entity entity)
+	{
+		Entity newEntity = CreateEntityWithUuid(entity.GetUUID(), entity.GetName());
+		CopyAllExistingComponents(newEntity, entity);
+		return newEntity;
+	}
+
 	void Scene::DestroyEntity(Entity entity)
 	{
-		m_EntityMap.erase(entity.GetUUID());
+		const UUID uuid = entity.GetUUID();
+		ScriptEngine::ReleaseCachedString(uuid);
+
+		m_EntityMap.erase(uuid);
 		m_Registry.destroy(entity);
 	}
 
@@ -302,16 +345,45 @@ namespace Hazel
 
 	Entity Scene::FindEntityByName(std::string_view name)
 	{
-		const auto view = m_Registry.view<TagComponent>();
-		for (const auto entityId : view)
+		const auto [begin, end] = m_EntityNameIndex.equal_range(std::hash<std::string_view>{}(name));
+		for (auto it = begin; it != end; ++it)
 		{
-			if (view.get<TagComponent>(entityId).Tag == name)
-				return { entityId, this };
+			if (m_Registry.get<TagComponent>(it->second).Tag == name)
+				return { it->second, this };
 		}
 
 		return {};
 	}
 
+	std::vector<Entity> Scene::FindEntitiesByName(std::string_view name)
+	{
+		std::vector<Entity> entities;
+
+		const auto [begin, end] = m_EntityNameIndex.equal_range(std::hash<std::string_view>{}(name));
+		for (auto it = begin; it != end; ++it)
+		{
+			if (m_Registry.get<TagComponent>(it->second).Tag == name)
+				entities.emplace_back(it->second, this);
+		}
+
+		return entities;
+	}
+
+	std::vector<Entity> Scene::FindEntitiesByNamePrefix(std::string_view prefix)
+	{
+		std::vector<Entity> entities;
+
+		for (auto it = m_SortedEntityNames.lower_bound(prefix); it != m_SortedEntityNames.end(); ++it)
+		{
+			if (it->first.compare(0, prefix.size(), prefix) != 0)
+				break;
+
+			entities.emplace_back(it->second, this);
+		}
+
+		return entities;
+	}
+
 	Entity Scene::GetPrimaryCameraEntity()
 	{
 		const auto view = m_Registry.view<CameraComponent>();
@@ -435,4 +507,75 @@ namespace Hazel
 		nsc.Instance->m_Entity = Entity{ entity, this };
 		nsc.Instance->OnCreate();
 	}
+
+	void Scene::OnTagComponentAdded(entt::registry& registry, entt::entity entity)
+	{
+		const auto& tag = registry.get<TagComponent>(entity).Tag;
+		m_EntityNameIndex.emplace(std::hash<std::string_view>{}(tag), entity);
+		m_EntityNameEntries[entity] = m_SortedEntityNames.emplace(tag, entity);
+	}
+
+	void Scene::OnTagComponentUpdated(entt::registry& registry, entt::entity entity)
+	{
+		RemoveFromNameIndex(entity);
+		OnTagComponentAdded(registry, entity);
+	}
+
+	void Scene::OnTagComponentRemoved(entt::registry& registry, entt::entity entity)
+	{
+		RemoveFromNameIndex(entity);
+	}
+
+	void Scene::RemoveFromNameIndex(EntityId entityId)
+	{
+		const auto entryIt = m_EntityNameEntries.find(entityId);
+		if (entryIt == m_EntityNameEntries.end())
+			return;
+
+		// The tag has already changed when this runs, so the previous name comes from the sorted index entry
+		const auto sortedIt = entryIt->second;
+		const auto [begin, end] = m_EntityNameIndex.equal_range(std::hash<std::string_view>{}(sortedIt->first));
+		for (auto it = begin; it != end; ++it)
+		{
+			if (it->second == entityId)
+			{
+				m_EntityNameIndex.erase(it);
+				break;
+			}
+		}
+
+		m_SortedEntityNames.erase(sortedIt);
+		m_EntityNameEntries.erase(entryIt);
+	}
+
+	void Scene::OnSpriteRendererComponentAdded(entt::registry& registry, entt::entity entity)
+	{
+		const AssetHandle texture = registry.get<SpriteRendererComponent>(entity).Texture;
+		if (texture == 0)
+			return;
+
+		AssetManager::Acquire(texture);
+		m_SpriteTextures[entity] = texture;
+	}
+
+	void Scene::OnSpriteRendererComponentUpdated(entt::registry& registry, entt::entity entity)
+	{
+		const AssetHandle texture = registry.get<SpriteRendererComponent>(entity).Texture;
+		const auto it = m_SpriteTextures.find(entity);
+		if (it != m_SpriteTextures.end() && it->second == texture)
+			return;
+
+		OnSpriteRendererComponentRemoved(registry, entity);
+		OnSpriteRendererComponentAdded(registry, entity);
+	}
+
+	void Scene::OnSpriteRendererComponentRemoved(entt::registry& registry, entt::entity entity)
+	{
+		const auto it = m_SpriteTextures.find(entity);
+		if (it == m_SpriteTextures.end())
+			return;
+
+		AssetManager::Release(it->second);
+		m_SpriteTextures.erase(it);
+	}
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Hazel/Asset/Asset.h"
 #include "Hazel/Core/Timestep.h"
 #include "Hazel/Core/UUID.h"
 #include "Hazel/Renderer/EditorCamera.h"
@@ -24,6 +25,8 @@ namespace Hazel
 		Entity CreateEntity(const std::string& name = std::string());
 		Entity CreateEntityWithUuid(UUID uuid, const std::string& name = std::string());
 		Entity DuplicateEntity(Entity entity);
+		// Copies an entity from another scene keeping its UUID
+		Entity ImportEntity(Entity entity);
 		void DestroyEntity(Entity entity);
 
 		void OnRuntimeStart();
@@ -37,8 +40,13 @@ namespace Hazel
 		void OnUpdateRuntime(Timestep ts);
 		void OnViewportResize(uint32_t width, uint32_t height);
 
+		// False for ids of entities that were destroyed since they were read, e.g. back from the GPU
+		bool IsEntityValid(EntityId id) const { return m_Registry.valid(id); }
+
 		Entity GetEntityByUUID(UUID id);
 		Entity FindEntityByName(std::string_view name);
+		std::vector<Entity> FindEntitiesByName(std::string_view name);
+		std::vector<Entity> FindEntitiesByNamePrefix(std::string_view prefix);
 
 		Entity GetPrimaryCameraEntity();
 
@@ -66,6 +74,15 @@ namespace Hazel
 		void OnCameraComponentAdded(entt::registry& registry, entt::entity entity) const;
 		void OnNativeScriptComponentAdded(entt::registry& registry, entt::entity entity);
 
+		void OnTagComponentAdded(entt::registry& registry, entt::entity entity);
+		void OnTagComponentUpdated(entt::registry& registry, entt::entity entity);
+		void OnTagComponentRemoved(entt::registry& registry, entt::entity entity);
+		void RemoveFromNameIndex(EntityId entityId);
+
+		void OnSpriteRendererComponentAdded(entt::registry& registry, entt::entity entity);
+		void OnSpriteRendererComponentUpdated(entt::registry& registry, entt::entity entity);
+		void OnSpriteRendererComponentRemoved(entt::registry& registry, entt::entity entity);
+
 	private:
 		entt::registry m_Registry;
 		uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0;
@@ -77,8 +94,19 @@ namespace Hazel
 
 		std::unordered_map<UUID, EntityId> m_EntityMap;
 
+		// Name indices kept in sync through the TagComponent signals.
+		// The hash index serves exact lookups (comparing the actual tag to resolve collisions), the sorted one serves prefix queries
+		using SortedNameIndex = std::multimap<std::string, EntityId, std::less<>>;
+		std::unordered_multimap<size_t, EntityId> m_EntityNameIndex;
+		SortedNameIndex m_SortedEntityNames;
+		std::unordered_map<EntityId, SortedNameIndex::iterator> m_EntityNameEntries;
+
+		// Texture each sprite currently holds a reference to, needed to release the old one when it changes
+		std::unordered_map<EntityId, AssetHandle> m_SpriteTextures;
+
 		friend class Entity;
 		friend class SceneSerializer;
+		friend class SceneBinarySerializer;
 		friend class SceneHierarchyPanel;
 	};
 }
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "Hazel/Scripting/ScriptEngine.h"
+
+#include <glm/glm.hpp>
+
+namespace Hazel
+{
+	// Binary scene layout (little-endian):
+	//   SceneFileHeader
+	//   UUID table:   uint64_t[EntityCount], entities are referenced by their index in this table
+	//   Chunks:       one per component type, SceneChunkHeader followed by its payload:
+	//                 uint32_t EntityIndices[Count], padding to 8 bytes, Record[Count]
+	//   String table: uint32_t Offsets[StringCount + 1] followed by the characters, strings are referenced by index
+	//
+	// Readers skip chunk types they don't know and copy min(RecordSize, sizeof(Record)) per record,
+	// so newer versions can append fields to a record or add chunks without breaking older files.
+	// Transform and CircleRenderer records match their component's layout exactly and are inserted into the
+	// registry straight from the mapped file, keep them in sync with Components.h.
+
+	constexpr uint32_t SCENE_BINARY_MAGIC = 'H' | ('Z' << 8) | ('S' << 16) | ('B' << 24);
+	constexpr uint32_t SCENE_BINARY_VERSION = 1;
+	constexpr uint32_t SCENE_BINARY_NULL_STRING = 0xFFFFFFFF;
+
+	enum class SceneChunkType : uint32_t
+	{
+		None = 0,
+		Tag, Transform, Camera, Script, ScriptField,
+		SpriteRenderer, CircleRenderer,
+		RigidBody2D, BoxCollider2D, CircleCollider2D,
+		Text
+	};
+
+	struct SceneFileHeader
+	{
+		uint32_t Magic = SCENE_BINARY_MAGIC;
+		uint32_t Version = SCENE_BINARY_VERSION;
+		uint32_t SceneName = SCENE_BINARY_NULL_STRING;
+		uint32_t EntityCount = 0;
+		uint32_t StringCount = 0;
+		uint32_t ChunkCount = 0;
+		uint64_t UUIDTableOffset = 0;
+		uint64_t ChunksOffset = 0;
+		uint64_t StringTableOffset = 0;
+	};
+
+	struct SceneChunkHeader
+	{
+		SceneChunkType Type = SceneChunkType::None;
+		uint32_t Count = 0;
+		uint32_t RecordSize = 0;
+		uint32_t RecordsOffset = 0; // From the start of the payload
+		uint64_t Size = 0; // Payload size in bytes
+	};
+
+	namespace SceneRecord
+	{
+		struct Tag
+		{
+			uint32_t Name;
+		};
+
+		struct Transform
+		{
+			glm::vec3 Position;
+			glm::vec3 Rotation;
+			glm::vec3 Scale;
+		};
+
+		struct Camera
+		{
+			uint32_t ProjectionType;
+			float PerspectiveFOV, PerspectiveNear, PerspectiveFar;
+			float OrthographicSize, OrthographicNear, OrthographicFar;
+			uint8_t Primary;
+			uint8_t FixedAspectRatio;
+			uint8_t Padding[2];
+		};
+
+		struct Script
+		{
+			uint32_t ClassName;
+		};
+
+		// An entity has one of these per field set in the editor
+		struct ScriptField
+		{
+			uint32_t Name;
+			uint32_t Type;
+			uint8_t Data[MAX_SCRIPT_FIELD_BUFFER_SIZE];
+		};
+
+		struct SpriteRenderer
+		{
+			glm::vec4 Color;
+			uint32_t TexturePath;
+			float TilingFactor;
+		};
+
+		struct CircleRenderer
+		{
+			glm::vec4 Color;
+			float Radius;
+			float Thickness;
+			float Fade;
+		};
+
+		struct RigidBody2D
+		{
+			uint32_t BodyType;
+			uint8_t FixedRotation;
+			uint8_t Padding[3];
+		};
+
+		struct BoxCollider2D
+		{
+			glm::vec2 Offset;
+			glm::vec2 Size;
+			float Density, Friction, Restitution, RestitutionThreshold;
+		};
+
+		struct CircleCollider2D
+		{
+			glm::vec2 Offset;
+			float Radius;
+			float Density, Friction, Restitution, RestitutionThreshold;
+		};
+
+		struct Text
+		{
+			uint32_t TextString;
+			float Kerning;
+			float LineSpacing;
+			glm::vec4 Color;
+		};
+	}
+}
@@ -0,0 +1,735 @@
+#include "hzpch.h"
+#include "Hazel/Scene/SceneBinarySerializer.h"
+
+#include "Hazel/Asset/AssetManager.h"
+
+#include "Hazel/Scene/Components.h"
+#include "Hazel/Scene/Entity.h"
+#include "Hazel/Scene/SceneBinaryFormat.h"
+#include "Hazel/Scene/SceneSerializer.h"
+
+#include "Hazel/Scripting/ScriptEngine.h"
+
+#include <fstream>
+
+namespace Hazel
+{
+	namespace Utils
+	{
+		class BinaryWriter
+		{
+		public:
+			template<typename T>
+			void Write(const T& value)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				WriteBytes(&value, sizeof(T));
+			}
+
+			template<typename T>
+			void WriteAt(size_t position, const T& value)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				HZ_CORE_ASSERT(position + sizeof(T) <= m_Data.size());
+				memcpy(m_Data.data() + position, &value, sizeof(T));
+			}
+
+			void WriteBytes(const void* data, size_t size)
+			{
+				const auto* bytes = (const uint8_t*)data;
+				m_Data.insert(m_Data.end(), bytes, bytes + size);
+			}
+
+			void Align(size_t alignment)
+			{
+				m_Data.resize((m_Data.size() + alignment - 1) & ~(alignment - 1), 0);
+			}
+
+			size_t GetPosition() const { return m_Data.size(); }
+			const std::vector<uint8_t>& GetData() const { return m_Data; }
+
+		private:
+			std::vector<uint8_t> m_Data;
+		};
+
+		class StringTableBuilder
+		{
+		public:
+			uint32_t Add(const std::string& string)
+			{
+				const auto [it, inserted] = m_Indices.try_emplace(string, (uint32_t)m_Strings.size());
+				if (inserted)
+					m_Strings.push_back(&it->first);
+
+				return it->second;
+			}
+
+			uint32_t GetCount() const { return (uint32_t)m_Strings.size(); }
+
+			void Write(BinaryWriter& writer) const
+			{
+				uint32_t offset = 0;
+				for (const std::string* string : m_Strings)
+				{
+					writer.Write(offset);
+					offset += (uint32_t)string->size();
+				}
+				writer.Write(offset);
+
+				for (const std::string* string : m_Strings)
+					writer.WriteBytes(string->data(), string->size());
+			}
+
+		private:
+			std::unordered_map<std::string, uint32_t> m_Indices;
+			std::vector<const std::string*> m_Strings;
+		};
+
+		class StringTableView
+		{
+		public:
+			bool Init(const uint8_t* data, uint64_t available, uint32_t count)
+			{
+				if (((uint64_t)count + 1) * sizeof(uint32_t) > available)
+					return false;
+
+				m_Offsets = (const uint32_t*)data;
+				m_Chars = (const char*)(m_Offsets + count + 1);
+				m_Count = count;
+
+				const uint64_t charsAvailable = available - ((uint64_t)count + 1) * sizeof(uint32_t);
+				if (m_Offsets[count] > charsAvailable)
+					return false;
+
+				// Every string then ends inside the mapped file as long as the last offset does
+				for (uint32_t i = 0; i < count; i++)
+				{
+					if (m_Offsets[i] > m_Offsets[i + 1])
+						return false;
+				}
+
+				return true;
+			}
+
+			std::string_view Get(uint32_t index) const
+			{
+				if (index >= m_Count)
+					return {};
+
+				return { m_Chars + m_Offsets[index], m_Offsets[index + 1] - m_Offsets[index] };
+			}
+
+		private:
+			const uint32_t* m_Offsets = nullptr;
+			const char* m_Chars = nullptr;
+			uint32_t m_Count = 0;
+		};
+
+		struct ChunkView
+		{
+			const SceneChunkHeader* Header = nullptr;
+			const uint32_t* EntityIndices = nullptr;
+			const uint8_t* Records = nullptr;
+
+			template<typename T>
+			T GetRecord(uint32_t index) const
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				T record{};
+				memcpy(&record, Records + (uint64_t)index * Header->RecordSize, std::min<size_t>(sizeof(T), Header->RecordSize));
+				return record;
+			}
+		};
+
+		static void WriteChunk(BinaryWriter& writer, SceneChunkType type, const std::vector<uint32_t>& entityIndices, const void* records, uint32_t recordSize)
+		{
+			const size_t headerPosition = writer.GetPosition();
+			writer.Write(SceneChunkHeader{});
+
+			const size_t payloadStart = writer.GetPosition();
+			writer.WriteBytes(entityIndices.data(), entityIndices.size() * sizeof(uint32_t));
+			writer.Align(8);
+
+			const size_t recordsStart = writer.GetPosition();
+			writer.WriteBytes(records, entityIndices.size() * recordSize);
+			writer.Align(8);
+
+			SceneChunkHeader header;
+			header.Type = type;
+			header.Count = (uint32_t)entityIndices.size();
+			header.RecordSize = recordSize;
+			header.RecordsOffset = (uint32_t)(recordsStart - payloadStart);
+			header.Size = writer.GetPosition() - payloadStart;
+			writer.WriteAt(headerPosition, header);
+		}
+
+		// Records that share the component's memory layout are inserted straight from the mapped file
+		template<typename Component, typename Record>
+		constexpr bool IsDirectRecord = false;
+
+		template<> constexpr bool IsDirectRecord<TransformComponent, SceneRecord::Transform> = true;
+		template<> constexpr bool IsDirectRecord<CircleRendererComponent, SceneRecord::CircleRenderer> = true;
+
+		static_assert(sizeof(TransformComponent) == sizeof(SceneRecord::Transform) && std::is_trivially_copyable_v<TransformComponent>);
+		static_assert(offsetof(TransformComponent, Position) == offsetof(SceneRecord::Transform, Position));
+		static_assert(offsetof(TransformComponent, Rotation) == offsetof(SceneRecord::Transform, Rotation));
+		static_assert(offsetof(TransformComponent, Scale) == offsetof(SceneRecord::Transform, Scale));
+
+		static_assert(sizeof(CircleRendererComponent) == sizeof(SceneRecord::CircleRenderer) && std::is_trivially_copyable_v<CircleRendererComponent>);
+		static_assert(offsetof(CircleRendererComponent, Color) == offsetof(SceneRecord::CircleRenderer, Color));
+		static_assert(offsetof(CircleRendererComponent, Radius) == offsetof(SceneRecord::CircleRenderer, Radius));
+		static_assert(offsetof(CircleRendererComponent, Thickness) == offsetof(SceneRecord::CircleRenderer, Thickness));
+		static_assert(offsetof(CircleRendererComponent, Fade) == offsetof(SceneRecord::CircleRenderer, Fade));
+
+		template<typename Component, typename Record, typename Func>
+		static void InsertComponents(entt::registry& registry, const ChunkView& chunk, const std::vector<EntityId>& entityIds, Func fromRecord)
+		{
+			const uint32_t count = chunk.Header->Count;
+
+			std::vector<EntityId> chunkEntities(count);
+			for (uint32_t i = 0; i < count; i++)
+				chunkEntities[i] = entityIds[chunk.EntityIndices[i]];
+
+			if constexpr (IsDirectRecord<Component, Record>)
+			{
+				if (chunk.Header->RecordSize == sizeof(Component))
+				{
+					registry.insert<Component>(chunkEntities.begin(), chunkEntities.end(), (const Component*)chunk.Records);
+					return;
+				}
+			}
+
+			std::vector<Component> components;
+			components.reserve(count);
+			for (uint32_t i = 0; i < count; i++)
+				components.push_back(fromRecord(chunk.GetRecord<Record>(i)));
+
+			registry.insert<Component>(chunkEntities.begin(), chunkEntities.end(), std::make_move_iterator(components.begin()));
+		}
+
+		template<typename Component, typename Record, typename Func>
+		static bool WriteComponentChunk(BinaryWriter& writer, SceneChunkType type, entt::registry& registry, const std::unordered_map<EntityId, uint32_t>& entityIndices, Func toRecord)
+		{
+			static_assert(std::is_trivially_copyable_v<Record>);
+
+			const auto view = registry.view<Component>();
+			if (view.empty())
+				return false;
+
+			std::vector<uint32_t> indices;
+			std::vector<Record> records;
+			indices.reserve(view.size());
+			records.reserve(view.size());
+
+			for (const auto entityId : view)
+			{
+				indices.push_back(entityIndices.at(entityId));
+				records.push_back(toRecord(view.template get<Component>(entityId)));
+			}
+
+			WriteChunk(writer, type, indices, records.data(), sizeof(Record));
+			return true;
+		}
+	}
+
+	SceneBinarySerializer::SceneBinarySerializer(const Ref<Scene>& scene)
+		: m_Scene(scene)
+	{
+	}
+
+	bool SceneBinarySerializer::Serialize(const FilePath& filepath) const
+	{
+		auto& registry = m_Scene->m_Registry;
+
+		Utils::BinaryWriter writer;
+		Utils::StringTableBuilder strings;
+
+		// Same entity order as the YAML serializer
+		std::vector<EntityId> entityIds;
+		std::unordered_map<EntityId, uint32_t> entityIndices;
+		registry.each([&](EntityId entityId)
+		{
+			if (!registry.all_of<IdComponent>(entityId))
+				return;
+
+			entityIndices[entityId] = (uint32_t)entityIds.size();
+			entityIds.push_back(entityId);
+		});
+
+		SceneFileHeader header;
+		header.SceneName = strings.Add("Untitled");
+		header.EntityCount = (uint32_t)entityIds.size();
+		writer.Write(header);
+
+		writer.Align(8);
+		header.UUIDTableOffset = writer.GetPosition();
+		for (const auto entityId : entityIds)
+			writer.Write((uint64_t)registry.get<IdComponent>(entityId).Id);
+
+		writer.Align(8);
+		header.ChunksOffset = writer.GetPosition();
+
+		header.ChunkCount += Utils::WriteComponentChunk<TagComponent, SceneRecord::Tag>(writer, SceneChunkType::Tag, registry, entityIndices, [&](const TagComponent& tc)
+		{
+			return SceneRecord::Tag{ strings.Add(tc.Tag) };
+		});
+
+		header.ChunkCount += Utils::WriteComponentChunk<TransformComponent, SceneRecord::Transform>(writer, SceneChunkType::Transform, registry, entityIndices, [](const TransformComponent& tc)
+		{
+			return SceneRecord::Transform{ tc.Position, tc.Rotation, tc.Scale };
+		});
+
+		header.ChunkCount += Utils::WriteComponentChunk<CameraComponent, SceneRecord::Camera>(writer, SceneChunkType::Camera, registry, entityIndices, [](const CameraComponent& cc)
+		{
+			const auto& camera = cc.Camera;
+
+			SceneRecord::Camera record{};
+			record.ProjectionType = (uint32_t)camera.GetProjectionType();
+			record.PerspectiveFOV = camera.GetPerspectiveVerticalFOV();
+			record.PerspectiveNear = camera.GetPerspectiveNearClip();
+			record.PerspectiveFar = camera.GetPerspectiveFarClip();
+			record.OrthographicSize = camera.GetOrthographicSize();
+			record.OrthographicNear = camera.GetOrthographicNearClip();
+			record.OrthographicFar = camera.GetOrthographicFarClip();
+			record.Primary = cc.Primary;
+			record.FixedAspectRatio = cc.FixedAspectRatio;
+			return record;
+		});
+
+		header.ChunkCount += Utils::WriteComponentChunk<ScriptComponent, SceneRecord::Script>(writer, SceneChunkType::Script, registry, entityIndices, [&](const ScriptComponent& sc)
+		{
+			return SceneRecord::Script{ strings.Add(sc.ClassName) };
+		});
+
+		// Script fields set in the editor
+		{
+			std::vector<uint32_t> indices;
+			std::vector<SceneRecord::ScriptField> records;
+
+			for (const auto entityId : registry.view<ScriptComponent>())
+			{
+				// Same as the text format, only values of the current class's fields are written
+				const auto& sc = registry.get<ScriptComponent>(entityId);
+				Ref<ScriptClass> entityClass = ScriptEngine::GetEntityClass(sc.ClassName);
+				if (!entityClass)
+					continue;
+
+				const auto& entityFields = ScriptEngine::GetScriptFieldMap({ entityId, m_Scene.get() });
+				for (const auto& field : entityClass->GetFields())
+				{
+					const ScriptFieldInstance* sfi = entityFields.Find(field);
+					if (!sfi)
+						continue;
+
+					SceneRecord::ScriptField record{};
+					record.Name = strings.Add(field.Name);
+					record.Type = (uint32_t)field.Type;
+					memcpy(record.Data, sfi->m_Buffer, MAX_SCRIPT_FIELD_BUFFER_SIZE);
+
+					indices.push_back(entityIndices.at(entityId));
+					records.push_back(record);
+				}
+			}
+
+			if (!records.empty())
+			{
+				Utils::WriteChunk(writer, SceneChunkType::ScriptField, indices, records.data(), sizeof(SceneRecord::ScriptField));
+				header.ChunkCount++;
+			}
+		}
+
+		header.ChunkCount += Utils::WriteComponentChunk<SpriteRendererComponent, SceneRecord::SpriteRenderer>(writer, SceneChunkType::SpriteRenderer, registry, entityIndices, [&](const SpriteRendererComponent& src)
+		{
+			SceneRecord::SpriteRenderer record{};
+			record.Color = src.Color;
+			record.TexturePath = src.Texture ? strings.Add(AssetManager::GetAssetPath(src.Texture).string()) : SCENE_BINARY_NULL_STRING;
+			record.TilingFactor = src.TilingFactor;
+			return record;
+		});
+
+		header.ChunkCount += Utils::WriteComponentChunk<CircleRendererComponent, SceneRecord::CircleRenderer>(writer, SceneChunkType::CircleRenderer, registry, entityIndices, [](const CircleRendererComponent& crc)
+		{
+			return SceneRecord::CircleRenderer{ crc.Color, crc.Radius, crc.Thickness, crc.Fade };
+		});
+
+		header.ChunkCount += Utils::WriteComponentChunk<RigidBody2DComponent, SceneRecord::RigidBody2D>(writer, SceneChunkType::RigidBody2D, registry, entityIndices, [](const RigidBody2DComponent& rb2d)
+		{
+			SceneRecord::RigidBody2D record{};
+			record.BodyType = (uint32_t)rb2d.Type;
+			record.FixedRotation = rb2d.FixedRotation;
+			return record;
+		});
+
+		header.ChunkCount += Utils::WriteComponentChunk<BoxCollider2DComponent, SceneRecord::BoxCollider2D>(writer, SceneChunkType::BoxCollider2D, registry, entityIndices, [](const BoxCollider2DComponent& bc2d)
+		{
+			return SceneRecord::BoxCollider2D{ bc2d.Offset, bc2d.Size, bc2d.Density, bc2d.Friction, bc2d.Restitution, bc2d.RestitutionThreshold };
+		});
+
+		header.ChunkCount += Utils::WriteComponentChunk<CircleCollider2DComponent, SceneRecord::CircleCollider2D>(writer, SceneChunkType::CircleCollider2D, registry, entityIndices, [](const CircleCollider2DComponent& cc2d)
+		{
+			return SceneRecord::CircleCollider2D{ cc2d.Offset, cc2d.Radius, cc2d.Density, cc2d.Friction, cc2d.Restitution, cc2d.RestitutionThreshold };
+		});
+
+		header.ChunkCount += Utils::WriteComponentChunk<TextComponent, SceneRecord::Text>(writer, SceneChunkType::Text, registry, entityIndices, [&](const TextComponent& tc)
+		{
+			return SceneRecord::Text{ strings.Add(tc.TextString), tc.Kerning, tc.LineSpacing, tc.Color };
+		});
+
+		// Written last so every chunk could add to it
+		header.StringTableOffset = writer.GetPosition();
+		header.StringCount = strings.GetCount();
+		strings.Write(writer);
+
+		writer.WriteAt(0, header);
+
+		std::ofstream stream(filepath, std::ios::binary);
+		if (!stream)
+		{
+			HZ_CORE_ERROR("Could not open {0} for writing", filepath);
+			return false;
+		}
+
+		const auto& data = writer.GetData();
+		stream.write((const char*)data.data(), (std::streamsize)data.size());
+		return stream.good();
+	}
+
+	bool SceneBinarySerializer::Deserialize(const FilePath& filepath, SceneStagingData* staging) const
+	{
+		MappedFile file(filepath);
+		if (!file || file.Size() < sizeof(SceneFileHeader))
+		{
+			HZ_CORE_ERROR("Could not read binary scene file {0}", filepath);
+			return false;
+		}
+
+		const uint8_t* data = file.Data();
+		const uint64_t size = file.Size();
+
+		SceneFileHeader header;
+		memcpy(&header, data, sizeof(SceneFileHeader));
+
+		if (header.Magic != SCENE_BINARY_MAGIC)
+		{
+			HZ_CORE_ERROR("{0} is not a binary scene file", filepath);
+			return false;
+		}
+
+		if (header.Version > SCENE_BINARY_VERSION)
+		{
+			HZ_CORE_ERROR("Binary scene {0} has version {1}, the newest supported version is {2}", filepath, header.Version, SCENE_BINARY_VERSION);
+			return false;
+		}
+
+		if (header.UUIDTableOffset + (uint64_t)header.EntityCount * sizeof(uint64_t) > size || header.ChunksOffset > size || header.StringTableOffset > size)
+		{
+			HZ_CORE_ERROR("Binary scene {0} is truncated", filepath);
+			return false;
+		}
+
+		Utils::StringTableView strings;
+		if (!strings.Init(data + header.StringTableOffset, size - header.StringTableOffset, header.StringCount))
+		{
+			HZ_CORE_ERROR("Binary scene {0} has an invalid string table", filepath);
+			return false;
+		}
+
+		// Validate every chunk up front so the rest of the load can trust the offsets
+		std::vector<Utils::ChunkView> chunks;
+		chunks.reserve(header.ChunkCount);
+
+		uint64_t offset = header.ChunksOffset;
+		for (uint32_t i = 0; i < header.ChunkCount; i++)
+		{
+			if (offset + sizeof(SceneChunkHeader) > size)
+			{
+				HZ_CORE_ERROR("Binary scene {0} is truncated", filepath);
+				return false;
+			}
+
+			const auto* chunkHeader = (const SceneChunkHeader*)(data + offset);
+			const uint64_t payloadStart = offset + sizeof(SceneChunkHeader);
+			const uint64_t recordsSize = (uint64_t)chunkHeader->Count * chunkHeader->RecordSize;
+
+			if (payloadStart + chunkHeader->Size > size
+				|| (uint64_t)chunkHeader->Count * sizeof(uint32_t) > chunkHeader->RecordsOffset
+				|| chunkHeader->RecordsOffset + recordsSize > chunkHeader->Size)
+			{
+				HZ_CORE_ERROR("Binary scene {0} has an invalid chunk", filepath);
+				return false;
+			}
+
+			Utils::ChunkView& chunk = chunks.emplace_back();
+			chunk.Header = chunkHeader;
+			chunk.EntityIndices = (const uint32_t*)(data + payloadStart);
+			chunk.Records = data + payloadStart + chunkHeader->RecordsOffset;
+
+			for (uint32_t j = 0; j < chunkHeader->Count; j++)
+			{
+				if (chunk.EntityIndices[j] >= header.EntityCount)
+				{
+					HZ_CORE_ERROR("Binary scene {0} references an entity out of range", filepath);
+					return false;
+				}
+			}
+
+			offset = payloadStart + chunkHeader->Size;
+		}
+
+		HZ_CORE_TRACE("Deserializing binary scene '{0}'", strings.Get(header.SceneName));
+
+		// Entities and their always-present components are created in bulk instead of going through CreateEntityWithUuid
+		auto& registry = m_Scene->m_Registry;
+		const uint32_t entityCount = header.EntityCount;
+
+		std::vector<EntityId> entityIds(entityCount);
+		registry.create(entityIds.begin(), entityIds.end());
+
+		{
+			const auto* uuids = (const uint64_t*)(data + header.UUIDTableOffset);
+
+			std::vector<IdComponent> idComponents;
+			idComponents.reserve(entityCount);
+			m_Scene->m_EntityMap.reserve(m_Scene->m_EntityMap.size() + entityCount);
+			for (uint32_t i = 0; i < entityCount; i++)
+			{
+				idComponents.emplace_back(uuids[i]);
+				m_Scene->m_EntityMap[uuids[i]] = entityIds[i];
+			}
+
+			registry.insert<IdComponent>(entityIds.begin(), entityIds.end(), idComponents.begin());
+		}
+
+		{
+			std::vector<TagComponent> tagComponents(entityCount);
+			for (const auto& chunk : chunks)
+			{
+				if (chunk.Header->Type != SceneChunkType::Tag)
+					continue;
+
+				for (uint32_t i = 0; i < chunk.Header->Count; i++)
+					tagComponents[chunk.EntityIndices[i]].Tag = strings.Get(chunk.GetRecord<SceneRecord::Tag>(i).Name);
+			}
+
+			for (auto& tc : tagComponents)
+			{
+				if (tc.Tag.empty())
+					tc.Tag = "Entity";
+			}
+
+			registry.insert<TagComponent>(entityIds.begin(), entityIds.end(), std::make_move_iterator(tagComponents.begin()));
+		}
+
+		// Entities always have transforms, the ones missing from the chunk get a default one
+		{
+			std::vector<bool> hasTransform(entityCount, false);
+			for (const auto& chunk : chunks)
+			{
+				if (chunk.Header->Type != SceneChunkType::Transform)
+					continue;
+
+				for (uint32_t i = 0; i < chunk.Header->Count; i++)
+					hasTransform[chunk.EntityIndices[i]] = true;
+
+				Utils::InsertComponents<TransformComponent, SceneRecord::Transform>(registry, chunk, entityIds, [](const SceneRecord::Transform& record)
+				{
+					TransformComponent tc;
+					tc.Position = record.Position;
+					tc.Rotation = record.Rotation;
+					tc.Scale = record.Scale;
+					return tc;
+				});
+			}
+
+			std::vector<EntityId> remaining;
+			for (uint32_t i = 0; i < entityCount; i++)
+			{
+				if (!hasTransform[i])
+					remaining.push_back(entityIds[i]);
+			}
+			registry.insert<TransformComponent>(remaining.begin(), remaining.end());
+		}
+
+		for (const auto& chunk : chunks)
+		{
+			const uint32_t count = chunk.Header->Count;
+
+			switch (chunk.Header->Type)
+			{
+				case SceneChunkType::Tag:
+				case SceneChunkType::Transform:
+					break;
+
+				case SceneChunkType::Camera:
+				{
+					// Few of these, and the camera has to go through its setters to build the projection
+					for (uint32_t i = 0; i < count; i++)
+					{
+						const auto record = chunk.GetRecord<SceneRecord::Camera>(i);
+
+						auto& cc = registry.emplace<CameraComponent>(entityIds[chunk.EntityIndices[i]]);
+						cc.Camera.SetProjectionType((SceneCamera::ProjectionType)record.ProjectionType);
+						cc.Camera.SetPerspectiveVerticalFOV(record.PerspectiveFOV);
+						cc.Camera.SetPerspectiveNearClip(record.PerspectiveNear);
+						cc.Camera.SetPerspectiveFarClip(record.PerspectiveFar);
+						cc.Camera.SetOrthographicSize(record.OrthographicSize);
+						cc.Camera.SetOrthographicNearClip(record.OrthographicNear);
+						cc.Camera.SetOrthographicFarClip(record.OrthographicFar);
+						cc.Primary = record.Primary;
+						cc.FixedAspectRatio = record.FixedAspectRatio;
+					}
+					break;
+				}
+
+				case SceneChunkType::Script:
+				{
+					Utils::InsertComponents<ScriptComponent, SceneRecord::Script>(registry, chunk, entityIds, [&](const SceneRecord::Script& record)
+					{
+						ScriptComponent sc;
+						sc.ClassName = strings.Get(record.ClassName);
+						return sc;
+					});
+					break;
+				}
+
+				case SceneChunkType::ScriptField:
+				{
+					// Only the serialized values are read here, they're bound to the class fields by the ScriptEngine
+					std::unordered_map<UUID, std::vector<SerializedScriptField>> localFields;
+					auto& scriptFields = staging ? staging->ScriptFields : localFields;
+
+					for (uint32_t i = 0; i < count; i++)
+					{
+						const auto record = chunk.GetRecord<SceneRecord::ScriptField>(i);
+						Entity entity = { entityIds[chunk.EntityIndices[i]], m_Scene.get() };
+						if (!entity.HasComponent<ScriptComponent>())
+							continue;
+
+						SerializedScriptField& field = scriptFields[entity.GetUUID()].emplace_back();
+						field.Name = strings.Get(record.Name);
+						field.Type = (ScriptFieldType)record.Type;
+						memcpy(field.Data, record.Data, MAX_SCRIPT_FIELD_BUFFER_SIZE);
+					}
+
+					for (const auto& [uuid, fields] : localFields)
+						ScriptEngine::SetSerializedFieldValues(m_Scene->GetEntityByUUID(uuid), fields);
+					break;
+				}
+
+				case SceneChunkType::SpriteRenderer:
+				{
+					Utils::InsertComponents<SpriteRendererComponent, SceneRecord::SpriteRenderer>(registry, chunk, entityIds, [&](const SceneRecord::SpriteRenderer& record)
+					{
+						SpriteRendererComponent src(record.Color);
+						if (record.TexturePath != SCENE_BINARY_NULL_STRING)
+							src.Texture = AssetManager::ImportAsset(FilePath(strings.Get(record.TexturePath)), AssetType::Texture2D);
+						src.TilingFactor = record.TilingFactor;
+						return src;
+					});
+					break;
+				}
+
+				case SceneChunkType::CircleRenderer:
+				{
+					Utils::InsertComponents<CircleRendererComponent, SceneRecord::CircleRenderer>(registry, chunk, entityIds, [](const SceneRecord::CircleRenderer& record)
+					{
+						CircleRendererComponent crc(record.Color);
+						crc.Radius = record.Radius;
+						crc.Thickness = record.Thickness;
+						crc.Fade = record.Fade;
+						return crc;
+					});
+					break;
+				}
+
+				case SceneChunkType::RigidBody2D:
+				{
+					Utils::InsertComponents<RigidBody2DComponent, SceneRecord::RigidBody2D>(registry, chunk, entityIds, [](const SceneRecord::RigidBody2D& record)
+					{
+						RigidBody2DComponent rb2d;
+						rb2d.Type = (RigidBody2DComponent::BodyType)record.BodyType;
+						rb2d.FixedRotation = record.FixedRotation;
+						return rb2d;
+					});
+					break;
+				}
+
+				case SceneChunkType::BoxCollider2D:
+				{
+					Utils::InsertComponents<BoxCollider2DComponent, SceneRecord::BoxCollider2D>(registry, chunk, entityIds, [](const SceneRecord::BoxCollider2D& record)
+					{
+						BoxCollider2DComponent bc2d;
+						bc2d.Offset = record.Offset;
+						bc2d.Size = record.Size;
+						bc2d.Density = record.Density;
+						bc2d.Friction = record.Friction;
+						bc2d.Restitution = record.Restitution;
+						bc2d.RestitutionThreshold = record.RestitutionThreshold;
+						return bc2d;
+					});
+					break;
+				}
+
+				case SceneChunkType::CircleCollider2D:
+				{
+					Utils::InsertComponents<CircleCollider2DComponent, SceneRecord::CircleCollider2D>(registry, chunk, entityIds, [](const SceneRecord::CircleCollider2D& record)
+					{
+						CircleCollider2DComponent cc2d;
+						cc2d.Offset = record.Offset;
+						cc2d.Radius = record.Radius;
+						cc2d.Density = record.Density;
+						cc2d.Friction = record.Friction;
+						cc2d.Restitution = record.Restitution;
+						cc2d.RestitutionThreshold = record.RestitutionThreshold;
+						return cc2d;
+					});
+					break;
+				}
+
+				case SceneChunkType::Text:
+				{
+					Utils::InsertComponents<TextComponent, SceneRecord::Text>(registry, chunk, entityIds, [&](const SceneRecord::Text& record)
+					{
+						TextComponent tc;
+						tc.TextString = strings.Get(record.TextString);
+						tc.Kerning = record.Kerning;
+						tc.LineSpacing = record.LineSpacing;
+						tc.Color = record.Color;
+						return tc;
+					});
+					break;
+				}
+
+				default:
+					HZ_CORE_WARN("Skipping unknown chunk type {0} in binary scene {1}", (uint32_t)chunk.Header->Type, filepath);
+					break;
+			}
+		}
+
+		return true;
+	}
+
+	bool SceneBinarySerializer::IsBinarySceneFile(const FilePath& filepath)
+	{
+		return filepath.extension() == Extension;
+	}
+
+	bool SceneBinarySerializer::ConvertToBinary(const FilePath& yamlPath, const FilePath& binaryPath)
+	{
+		auto scene = CreateRef<Scene>();
+		if (!SceneSerializer(scene).Deserialize(yamlPath))
+			return false;
+
+		return SceneBinarySerializer(scene).Serialize(binaryPath);
+	}
+
+	bool SceneBinarySerializer::ConvertToYAML(const FilePath& binaryPath, const FilePath& yamlPath)
+	{
+		auto scene = CreateRef<Scene>();
+		if (!SceneBinarySerializer(scene).Deserialize(binaryPath))
+			return false;
+
+		SceneSerializer(scene).Serialize(yamlPath);
+		return true;
+	}
+}
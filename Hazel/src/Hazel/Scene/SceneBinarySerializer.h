@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Hazel/Core/FileSystem.h"
+#include "Hazel/Scene/Scene.h"
+
+namespace Hazel
+{
+	struct SceneStagingData;
+
+	// Chunked binary counterpart of SceneSerializer, see SceneBinaryFormat.h for the layout
+	class SceneBinarySerializer
+	{
+	public:
+		SceneBinarySerializer(const Ref<Scene>& scene);
+
+		bool Serialize(const FilePath& filepath) const;
+		bool Deserialize(const FilePath& filepath, SceneStagingData* staging = nullptr) const;
+
+		static bool IsBinarySceneFile(const FilePath& filepath);
+
+		static bool ConvertToBinary(const FilePath& yamlPath, const FilePath& binaryPath);
+		static bool ConvertToYAML(const FilePath& binaryPath, const FilePath& yamlPath);
+
+		inline static const char* Extension = ".hsb";
+	private:
+		Ref<Scene> m_Scene;
+	};
+}
@@ -0,0 +1,141 @@
+#include "hzpch.h"
+#include "Hazel/Scene/SceneLoader.h"
+
+#include "Hazel/Asset/AssetManager.h"
+
+#include "Hazel/Core/Application.h"
+
+#include "Hazel/Renderer/Texture.h"
+
+#include "Hazel/Scene/Components.h"
+#include "Hazel/Scene/Entity.h"
+#include "Hazel/Scene/SceneBinarySerializer.h"
+
+#include "Hazel/Scripting/ScriptEngine.h"
+
+namespace Hazel
+{
+	Ref<SceneLoader> SceneLoader::LoadAsync(const FilePath& filepath, const CompletionCallback& onComplete, uint32_t entitiesPerFrame)
+	{
+		auto loader = CreateRef<SceneLoader>(filepath, onComplete, entitiesPerFrame);
+		loader->Start();
+		return loader;
+	}
+
+	SceneLoader::SceneLoader(const FilePath& filepath, const CompletionCallback& onComplete, uint32_t entitiesPerFrame)
+		: m_FilePath(filepath), m_OnComplete(onComplete), m_EntitiesPerFrame(std::max(entitiesPerFrame, 1u))
+	{
+		m_Scene = CreateRef<Scene>();
+	}
+
+	SceneLoader::~SceneLoader()
+	{
+		// Parsing can't be interrupted, if the load was cancelled while parsing this waits for it
+		if (m_Thread.joinable())
+			m_Thread.join();
+	}
+
+	float SceneLoader::GetProgress() const
+	{
+		if (m_Stage == SceneLoadStage::Done)
+			return 1.0f;
+
+		const uint32_t entityCount = m_EntityCount;
+		return entityCount > 0 ? (float)m_LoadedEntityCount / (float)entityCount : 0.0f;
+	}
+
+	void SceneLoader::Start()
+	{
+		// The worker only keeps a weak reference, so the loader is always destroyed on the main thread
+		m_Thread = std::thread([this, weakLoader = weak_from_this()]
+		{
+			Parse();
+
+			const bool parsed = m_StagingScene != nullptr;
+			Application::Get().SubmitToMainThread([weakLoader, parsed]
+			{
+				if (auto loader = weakLoader.lock())
+				{
+					if (parsed)
+						loader->StreamBatch();
+					else
+						loader->Finish(false);
+				}
+			});
+		});
+	}
+
+	void SceneLoader::Parse()
+	{
+		auto stagingScene = CreateRef<Scene>();
+
+		const bool loaded = SceneBinarySerializer::IsBinarySceneFile(m_FilePath)
+			? SceneBinarySerializer(stagingScene).Deserialize(m_FilePath, &m_StagingData)
+			: SceneSerializer(stagingScene).Deserialize(m_FilePath, &m_StagingData);
+
+		if (!loaded)
+		{
+			HZ_CORE_ERROR("Could not load scene {0}", m_FilePath);
+			return;
+		}
+
+		const auto view = stagingScene->GetAllEntitiesWith<IdComponent>();
+		m_StagedEntities.assign(view.begin(), view.end());
+		m_StagingScene = stagingScene;
+		m_EntityCount = (uint32_t)m_StagedEntities.size();
+	}
+
+	void SceneLoader::StreamBatch()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		m_Stage = SceneLoadStage::Streaming;
+
+		const uint32_t first = m_LoadedEntityCount;
+		const uint32_t last = std::min(first + m_EntitiesPerFrame, (uint32_t)m_StagedEntities.size());
+
+		for (uint32_t i = first; i < last; i++)
+		{
+			Entity entity = m_Scene->ImportEntity({ m_StagedEntities[i], m_StagingScene.get() });
+			const UUID uuid = entity.GetUUID();
+
+			// Start decoding the textures as soon as their entities arrive instead of when they are first drawn
+			if (entity.HasComponent<SpriteRendererComponent>())
+				AssetManager::GetAsset<Texture2D>(entity.GetComponent<SpriteRendererComponent>().Texture);
+
+			if (const auto it = m_StagingData.ScriptFields.find(uuid); it != m_StagingData.ScriptFields.end())
+				ScriptEngine::SetSerializedFieldValues(entity, it->second);
+		}
+
+		m_LoadedEntityCount = last;
+
+		if (last < m_StagedEntities.size())
+		{
+			Application::Get().SubmitToMainThread([weakLoader = weak_from_this()]
+			{
+				if (auto loader = weakLoader.lock())
+					loader->StreamBatch();
+			});
+			return;
+		}
+
+		Finish(true);
+	}
+
+	void SceneLoader::Finish(bool success)
+	{
+		if (m_Thread.joinable())
+			m_Thread.join();
+
+		m_StagingScene = nullptr;
+		m_StagingData = {};
+		m_StagedEntities = {};
+
+		m_Stage = success ? SceneLoadStage::Done : SceneLoadStage::Failed;
+		if (success)
+			HZ_CORE_TRACE("Finished loading scene {0} ({1} entities)", m_FilePath, m_LoadedEntityCount.load());
+
+		if (m_OnComplete)
+			m_OnComplete(m_Scene, success);
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Hazel/Core/FileSystem.h"
+#include "Hazel/Scene/Scene.h"
+#include "Hazel/Scene/SceneSerializer.h"
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+namespace Hazel
+{
+	enum class SceneLoadStage
+	{
+		Parsing = 0, Streaming, Done, Failed
+	};
+
+	// Loads a scene without blocking the main thread.
+	// The file is parsed on a worker thread into a staging scene, then its entities are moved into the
+	// target scene on the main thread in batches of at most EntitiesPerFrame, one batch per frame.
+	// Destroying the loader cancels the load, the completion callback is not called in that case.
+	class SceneLoader : public std::enable_shared_from_this<SceneLoader>
+	{
+	public:
+		using CompletionCallback = std::function<void(const Ref<Scene>& scene, bool success)>;
+
+		static Ref<SceneLoader> LoadAsync(const FilePath& filepath, const CompletionCallback& onComplete, uint32_t entitiesPerFrame = 256);
+
+		SceneLoader(const FilePath& filepath, const CompletionCallback& onComplete, uint32_t entitiesPerFrame);
+		~SceneLoader();
+
+		SceneLoader(const SceneLoader&) = delete;
+		SceneLoader& operator=(const SceneLoader&) = delete;
+
+		const FilePath& GetFilePath() const { return m_FilePath; }
+		const Ref<Scene>& GetScene() const { return m_Scene; }
+
+		SceneLoadStage GetStage() const { return m_Stage; }
+		bool IsDone() const { return m_Stage == SceneLoadStage::Done || m_Stage == SceneLoadStage::Failed; }
+
+		uint32_t GetEntityCount() const { return m_EntityCount; }
+		uint32_t GetLoadedEntityCount() const { return m_LoadedEntityCount; }
+		// 0 -> 1, parsing has no progress of its own so it reports 0 until the entities start streaming in
+		float GetProgress() const;
+	private:
+		void Start();
+		void Parse();
+		void StreamBatch();
+		void Finish(bool success);
+	private:
+		FilePath m_FilePath;
+		CompletionCallback m_OnComplete;
+		uint32_t m_EntitiesPerFrame;
+
+		Ref<Scene> m_Scene;
+
+		// Only touched by the worker until parsing is done, then only by the main thread
+		Ref<Scene> m_StagingScene;
+		SceneStagingData m_StagingData;
+		std::vector<EntityId> m_StagedEntities;
+
+		std::thread m_Thread;
+		std::atomic<SceneLoadStage> m_Stage = SceneLoadStage::Parsing;
+		std::atomic<uint32_t> m_EntityCount = 0;
+		std::atomic<uint32_t> m_LoadedEntityCount = 0;
+	};
+}
@@ -4,9 +4,11 @@
 #include <yaml-cpp/yaml.h>
 #include <fstream>
 
+#include "Hazel/Asset/AssetManager.h"
 #include "Hazel/Project/Project.h"
 #include "Hazel/Scene/Entity.h"
 #include "Hazel/Scene/Components.h"
+#include "Hazel/Scene/SceneBinarySerializer.h"
 
 #include "Hazel/Scripting/ScriptEngine.h"
 
@@ -20,7 +22,7 @@
 		case ScriptFieldType::FieldType:				\
 		{												\
 			auto data = scriptField["Data"].as<Type>(); \
-			sfi.SetValue(data);							\
+			field.SetValue(data);						\
 			break;										\
 		}												\
 
@@ -245,9 +247,10 @@ namespace Hazel
 				out << YAML::Key << "ScriptFields" << YAML::Value;  // ScriptFields
 				out << YAML::BeginSeq;
 
-				for (const auto& [name, field] : fields)
+				for (const auto& field : fields)
 				{
-					if (entityFields.find(name) == entityFields.end())
+					const ScriptFieldInstance* fieldInstance = entityFields.Find(field);
+					if (!fieldInstance)
 						continue;
 
 					// - Name: FieldName
@@ -255,11 +258,11 @@ namespace Hazel
 					//	 Data: 5
 
 					out << YAML::BeginMap; // Field
-					out << YAML::Key << "Name" << YAML::Value << name;
+					out << YAML::Key << "Name" << YAML::Value << field.Name;
 					out << YAML::Key << "Type" << YAML::Value << Utils::ScriptFieldTypeToString(field.Type);
 					out << YAML::Key << "Data" << YAML::Value;
 
-					const ScriptFieldInstance& sfi = entityFields.at(name);
+					const ScriptFieldInstance& sfi = *fieldInstance;
 
 					switch (field.Type)
 					{
@@ -299,7 +302,7 @@ namespace Hazel
 			const auto& spriteRendererComponent = entity.GetComponent<SpriteRendererComponent>();
 			out << YAML::Key << "Color" << YAML::Value << spriteRendererComponent.Color;
 			if (spriteRendererComponent.Texture)
-				out << YAML::Key << "TexturePath" << YAML::Value << spriteRendererComponent.Texture->GetPath().string();
+				out << YAML::Key << "TexturePath" << YAML::Value << AssetManager::GetAssetPath(spriteRendererComponent.Texture).string();
 
 			out << YAML::Key << "TilingFactor" << YAML::Value << spriteRendererComponent.TilingFactor;
 
@@ -403,11 +406,11 @@ namespace Hazel
 
 	void SceneSerializer::SerializeRuntime(const FilePath& filepath)
 	{
-		// NYI
-		HZ_CORE_ASSERT(false);
+		// Shipping builds load the binary format, it maps straight into the registry without parsing
+		SceneBinarySerializer(m_Scene).Serialize(filepath);
 	}
 
-	bool SceneSerializer::Deserialize(const FilePath& filepath) const
+	bool SceneSerializer::Deserialize(const FilePath& filepath, SceneStagingData* staging) const
 	{
 		YAML::Node data;
 		try
@@ -475,65 +478,55 @@ namespace Hazel
 
 					if (auto scriptFields = scriptComponent["ScriptFields"])
 					{
-						Ref<ScriptClass> entityClass = ScriptEngine::GetEntityClass(sc.ClassName);
-						if (entityClass)
+						// Only the serialized values are read here, they're bound to the class fields by the ScriptEngine
+						std::vector<SerializedScriptField> entityFields;
+						for (auto scriptField : scriptFields)
 						{
-							const auto& fields = entityClass->GetFields();
-							auto& entityFields = ScriptEngine::GetScriptFieldMap(deserializedEntity);
+							SerializedScriptField& field = entityFields.emplace_back();
+							field.Name = scriptField["Name"].as<std::string>();
+							field.Type = Utils::ScriptFieldTypeFromString(scriptField["Type"].as<std::string>());
 
-							for (auto scriptField : scriptFields)
+							switch (field.Type)
 							{
-								auto fieldName = scriptField["Name"].as<std::string>();
-								auto typeString = scriptField["Type"].as<std::string>();
-								ScriptFieldType fieldType = Utils::ScriptFieldTypeFromString(typeString);
-
-								if (fields.find(fieldName) == fields.end())
-								{
-									HZ_CORE_WARN("Field '{}' does not exist in Class '{}'", fieldName, sc.ClassName);
-									continue;
-								}
-
-								ScriptFieldInstance& sfi = entityFields[fieldName];
-								sfi.Field = fields.at(fieldName);
-
-								switch (fieldType)
-								{
-									READ_FIELD_CASE(Boolean, bool);
-									READ_FIELD_CASE(Byte, uint8_t);
-									READ_FIELD_CASE(SByte, int8_t);
-									READ_FIELD_CASE(UShort, uint16_t);
-									READ_FIELD_CASE(Short, int16_t);
-									READ_FIELD_CASE(UInt, uint32_t);
-									READ_FIELD_CASE(Int, int32_t);
-									READ_FIELD_CASE(ULong, uint64_t);
-									READ_FIELD_CASE(Long, int64_t);
-									READ_FIELD_CASE(Float, float);
-									READ_FIELD_CASE(Double, double);
-									READ_FIELD_CASE(Decimal, double);
-									READ_FIELD_CASE(Char, char);
-									// READ_FIELD_CASE(String, std::string); NYI
-									READ_FIELD_CASE(Vector2, glm::vec2);
-									READ_FIELD_CASE(Vector3, glm::vec3);
-									READ_FIELD_CASE(Vector4, glm::vec4);
-									READ_FIELD_CASE(Color, glm::vec4);
-									READ_FIELD_CASE(Entity, UUID);
-								}
+								READ_FIELD_CASE(Boolean, bool);
+								READ_FIELD_CASE(Byte, uint8_t);
+								READ_FIELD_CASE(SByte, int8_t);
+								READ_FIELD_CASE(UShort, uint16_t);
+								READ_FIELD_CASE(Short, int16_t);
+								READ_FIELD_CASE(UInt, uint32_t);
+								READ_FIELD_CASE(Int, int32_t);
+								READ_FIELD_CASE(ULong, uint64_t);
+								READ_FIELD_CASE(Long, int64_t);
+								READ_FIELD_CASE(Float, float);
+								READ_FIELD_CASE(Double, double);
+								READ_FIELD_CASE(Decimal, double);
+								READ_FIELD_CASE(Char, char);
+								// READ_FIELD_CASE(String, std::string); NYI
+								READ_FIELD_CASE(Vector2, glm::vec2);
+								READ_FIELD_CASE(Vector3, glm::vec3);
+								READ_FIELD_CASE(Vector4, glm::vec4);
+								READ_FIELD_CASE(Color, glm::vec4);
+								READ_FIELD_CASE(Entity, UUID);
 							}
 						}
+
+						if (staging)
+							staging->ScriptFields[uuid] = std::move(entityFields);
+						else
+							ScriptEngine::SetSerializedFieldValues(deserializedEntity, entityFields);
 					}
 				}
 
 				if (auto spriteRendererComponent = entity["SpriteRendererComponent"])
 				{
-					auto& src = deserializedEntity.AddComponent<SpriteRendererComponent>();
+					// Filled before adding it so the scene acquires the texture
+					SpriteRendererComponent src;
 					src.Color = spriteRendererComponent["Color"].as<glm::vec4>();
 					if (spriteRendererComponent["TexturePath"])
-					{
-						auto texturePath = spriteRendererComponent["TexturePath"].as<std::string>(); 
-						src.Texture = Texture2D::Create(texturePath);
-					}
+						src.Texture = AssetManager::ImportAsset(spriteRendererComponent["TexturePath"].as<std::string>(), AssetType::Texture2D);
 					if (spriteRendererComponent["TilingFactor"])
 						src.TilingFactor = spriteRendererComponent["TilingFactor"].as<float>();
+					deserializedEntity.AddComponent<SpriteRendererComponent>(src);
 				}
 
 				if (auto circleRendererComponent = entity["CircleRendererComponent"])
@@ -589,8 +582,6 @@ namespace Hazel
 
 	bool SceneSerializer::DeserializeRuntime(const FilePath& filepath)
 	{
-		// NYI
-		HZ_CORE_ASSERT(false);
-		return false;
+		return SceneBinarySerializer(m_Scene).Deserialize(filepath);
 	}
 }
@@ -2,9 +2,18 @@
 
 #include "Hazel/Core/FileSystem.h"
 #include "Hazel/Scene/Scene.h"
+#include "Hazel/Scripting/ScriptEngine.h"
 
 namespace Hazel
 {
+	// When a scene is deserialized off the main thread, anything that needs the ScriptEngine
+	// is collected here instead so the main thread can apply it later
+	struct SceneStagingData
+	{
+		// Bound to the script classes when each entity is imported, see ScriptEngine::SetSerializedFieldValues
+		std::unordered_map<UUID, std::vector<SerializedScriptField>> ScriptFields;
+	};
+
 	class SceneSerializer
 	{
 	public:
@@ -13,7 +22,7 @@ namespace Hazel
 		void Serialize(const FilePath& filepath);
 		void SerializeRuntime(const FilePath& filepath);
 
-		bool Deserialize(const FilePath& filepath) const;
+		bool Deserialize(const FilePath& filepath, SceneStagingData* staging = nullptr) const;
 		bool DeserializeRuntime(const FilePath& filepath);
 	private:
 		Ref<Scene> m_Scene;
@@ -3,6 +3,8 @@
 
 #include "Hazel/Core/Application.h"
 #include "Hazel/Core/FileSystem.h"
+#include "Hazel/Core/Hash.h"
+#include "Hazel/Core/Timer.h"
 #include "Hazel/Project/Project.h"
 #include "Hazel/Scene/Entity.h"
 #include "Hazel/Scene/Scene.h"
@@ -10,6 +12,7 @@
 
 #include <mono/jit/jit.h>
 #include <mono/metadata/assembly.h>
+#include <mono/metadata/class.h>
 #include <mono/metadata/mono-debug.h>
 #include <mono/metadata/object.h>
 #include <mono/metadata/tabledefs.h>
@@ -44,17 +47,28 @@ namespace Hazel
 
 	namespace Utils
 	{
-		static MonoAssembly* LoadMonoAssembly(const FilePath& assemblyPath, bool loadPDB = false)
+		static uint64_t HashFile(const FilePath& filepath)
 		{
-			ScopedBuffer fileData = FileSystem::ReadFileBinary(assemblyPath);
+			MappedFile file(filepath);
+			return file ? Hash::FNV1a(file.Data(), file.Size()) : 0;
+		}
+
+		static MonoAssembly* LoadMonoAssembly(const FilePath& assemblyPath, bool loadPDB = false, uint64_t* outHash = nullptr)
+		{
+			// Mono copies the image data, the mapping only needs to live until the image is opened.
+			// Keeping it mapped would also prevent the compiler from overwriting the file on the next build
+			MappedFile fileData(assemblyPath);
 			if (!fileData)
 			{
 				HZ_CORE_ERROR("Failed to read assembly: {0}", assemblyPath);
 				return nullptr;
 			}
 
+			if (outHash)
+				*outHash = Hash::FNV1a(fileData.Data(), fileData.Size());
+
 			MonoImageOpenStatus status;
-			MonoImage* image = mono_image_open_from_data_full(fileData.As<char>(), (uint32_t)fileData.Size(), 1, &status, 0);
+			MonoImage* image = mono_image_open_from_data_full(const_cast<char*>(fileData.As<char>()), (uint32_t)fileData.Size(), 1, &status, 0);
 
 			if (status != MONO_IMAGE_OK)
 			{
@@ -91,6 +105,28 @@ namespace Hazel
 			return assembly;
 		}
 
+		// Opens the image without loading it into a domain, so a reload can bail out before tearing down the current one
+		static bool IsValidAssembly(const FilePath& assemblyPath)
+		{
+			MappedFile fileData(assemblyPath);
+			if (!fileData)
+			{
+				HZ_CORE_ERROR("Failed to read assembly: {0}", assemblyPath);
+				return false;
+			}
+
+			MonoImageOpenStatus status;
+			MonoImage* image = mono_image_open_from_data_full(const_cast<char*>(fileData.As<char>()), (uint32_t)fileData.Size(), 1, &status, 0);
+			if (status != MONO_IMAGE_OK)
+			{
+				HZ_CORE_ERROR("Invalid assembly {0}: {1}", assemblyPath, mono_image_strerror(status));
+				return false;
+			}
+
+			mono_image_close(image);
+			return true;
+		}
+
 		static void PrintAssemblyTypes(MonoAssembly* assembly)
 		{
 			MonoImage* image = mono_assembly_get_image(assembly);
@@ -119,8 +155,55 @@ namespace Hazel
 
 			return it->second;
 		}
+
+		static bool FieldLayoutsMatch(const std::vector<ScriptField>& a, const std::vector<ScriptField>& b)
+		{
+			return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const ScriptField& fieldA, const ScriptField& fieldB)
+			{
+				return fieldA.Name == fieldB.Name && fieldA.Type == fieldB.Type;
+			});
+		}
+
+		// Reference fields have to be written through mono so the GC write barrier runs
+		static bool IsReferenceFieldType(ScriptFieldType fieldType)
+		{
+			return fieldType == ScriptFieldType::String || fieldType == ScriptFieldType::Entity;
+		}
+
+		// Reference types hold pointers into the old domain and cannot be carried across a reload
+		static bool IsSnapshotFieldType(ScriptFieldType fieldType)
+		{
+			return fieldType != ScriptFieldType::None && !IsReferenceFieldType(fieldType);
+		}
+
+		static FilePath GetAppAssemblyPath()
+		{
+			return Project::GetAssetDirectory() / Project::GetActive()->GetConfig().ScriptModulePath;
+		}
 	}
 
+	struct ScriptStateSnapshot
+	{
+		struct InstanceState
+		{
+			UUID EntityId;
+			std::string ClassName;
+			// Matched by name after the reload, the handles may have changed
+			std::vector<ScriptFieldInstance> Fields;
+		};
+
+		std::vector<InstanceState> Instances;
+
+		// Editor field maps store MonoClassField pointers, remember which class each one belonged to so they can be rebound
+		std::unordered_map<MonoClassField*, std::string> FieldOwners;
+	};
+
+	struct CachedString
+	{
+		uint32_t GCHandle = 0;
+		std::string Source;
+	};
+
 	struct ScriptEngineData
 	{
 		MonoDomain* RootDomain = nullptr;
@@ -139,8 +222,17 @@ namespace Hazel
 
 		std::unordered_map<UUID, ScriptFieldMap> EntityScriptFields;
 
+		// Managed strings handed out to scripts, kept alive so unchanged text is not reallocated every call
+		std::unordered_map<UUID, CachedString> StringCache;
+
+		uint64_t CoreAssemblyHash = 0;
+		uint64_t AppAssemblyHash = 0;
+
 		Scope<filewatch::FileWatch<std::string>> AppAssemblyFileWatcher;
 		bool AssemblyReloadPending = false;
+		// State captured by a reload that failed after the domain was torn down, restored by the next successful one
+		Scope<ScriptStateSnapshot> PendingSnapshot;
+		bool InternalCallsRegistered = false;
 
 		// Temp until finding out why mono release crashes
 		// TODO should be read from the config
@@ -169,6 +261,12 @@ namespace Hazel
 		}
 	}
 
+	static void WatchAppAssembly(const FilePath& assemblyPath)
+	{
+		s_Data->AppAssemblyFileWatcher = CreateScope<filewatch::FileWatch<std::string>>(assemblyPath.string(), OnAppAssemblyFileSystemEvent);
+		s_Data->AssemblyReloadPending = false;
+	}
+
 	void ScriptEngine::Init()
 	{
 		s_Data = new ScriptEngineData;
@@ -209,6 +307,8 @@ namespace Hazel
 
 	void ScriptEngine::ShutdownMono()
 	{
+		ClearStringCache();
+
 		mono_domain_set(mono_get_root_domain(), false);
 
 		mono_domain_unload(s_Data->AppDomain);
@@ -220,6 +320,8 @@ namespace Hazel
 
 	bool ScriptEngine::LoadCoreAssembly()
 	{
+		ClearStringCache();
+
 		mono_domain_set(mono_get_root_domain(), false);
 		if (s_Data->AppDomain)
 			mono_domain_unload(s_Data->AppDomain);
@@ -228,7 +330,7 @@ namespace Hazel
 		mono_domain_set(s_Data->AppDomain, true);
 
 		const FilePath& path = Application::Get().GetSpecification().ScriptEngineConfig.CoreAssemblyPath;
-		s_Data->CoreAssembly = Utils::LoadMonoAssembly(path, s_Data->EnableDebugging);
+		s_Data->CoreAssembly = Utils::LoadMonoAssembly(path, s_Data->EnableDebugging, &s_Data->CoreAssemblyHash);
 		if (!s_Data->CoreAssembly)
 		{
 			HZ_CORE_ERROR("Could not load Hazel-ScriptCore assembly.");
@@ -243,8 +345,8 @@ namespace Hazel
 
 	bool ScriptEngine::LoadAppAssembly()
 	{
-		const FilePath assemblyPath = Project::GetAssetDirectory() / Project::GetActive()->GetConfig().ScriptModulePath;
-		s_Data->AppAssembly = Utils::LoadMonoAssembly(assemblyPath, s_Data->EnableDebugging);
+		const FilePath assemblyPath = Utils::GetAppAssemblyPath();
+		s_Data->AppAssembly = Utils::LoadMonoAssembly(assemblyPath, s_Data->EnableDebugging, &s_Data->AppAssemblyHash);
 		if (!s_Data->AppAssembly)
 		{
 			HZ_CORE_ERROR("Could not load app assembly.");
@@ -256,26 +358,154 @@ namespace Hazel
 
 		LoadAssemblyClasses();
 		ScriptRegistry::RegisterComponents();
-		ScriptRegistry::RegisterMethods();
+
+		// Internal calls are registered with the runtime, not the domain, so they survive reloads
+		if (!s_Data->InternalCallsRegistered)
+		{
+			ScriptRegistry::RegisterMethods();
+			s_Data->InternalCallsRegistered = true;
+		}
 
 		MonoClass* entityMonoClass = mono_class_from_name(s_Data->CoreAssemblyImage, "Hazel", "Entity");
 		s_Data->EntityClass = ScriptClass(entityMonoClass);
 
-		s_Data->AppAssemblyFileWatcher = CreateScope<filewatch::FileWatch<std::string>>(assemblyPath.string(), OnAppAssemblyFileSystemEvent);
-		s_Data->AssemblyReloadPending = false;
-
+		WatchAppAssembly(assemblyPath);
 		return true;
 	}
 
 	void ScriptEngine::ReloadAssembly()
 	{
-		HZ_CORE_INFO("Reloading assemblies.");
+		const FilePath& coreAssemblyPath = Application::Get().GetSpecification().ScriptEngineConfig.CoreAssemblyPath;
+		const FilePath appAssemblyPath = Utils::GetAppAssemblyPath();
+
+		// A single build usually fires several change notifications, don't reload if the bytes are the same
+		// Unless a previous reload failed half way, in which case the domain has to be rebuilt regardless
+		if (!s_Data->PendingSnapshot && Utils::HashFile(coreAssemblyPath) == s_Data->CoreAssemblyHash && Utils::HashFile(appAssemblyPath) == s_Data->AppAssemblyHash)
+		{
+			HZ_CORE_INFO("Assemblies unchanged, skipping reload.");
+			WatchAppAssembly(appAssemblyPath);
+			return;
+		}
 
-		if (!LoadCoreAssembly())
+		// The build may still be writing the files, keep the current domain and try again on the next change
+		if (!Utils::IsValidAssembly(coreAssemblyPath) || !Utils::IsValidAssembly(appAssemblyPath))
+		{
+			HZ_CORE_ERROR("Could not reload assemblies, keeping the current ones.");
+			WatchAppAssembly(appAssemblyPath);
 			return;
+		}
+
+		HZ_CORE_INFO("Reloading assemblies.");
 
-		if (!LoadAppAssembly())
+		Timer timer;
+		if (!s_Data->PendingSnapshot)
+		{
+			s_Data->PendingSnapshot = CreateScope<ScriptStateSnapshot>();
+			SnapshotScriptState(*s_Data->PendingSnapshot);
+		}
+		const float snapshotTime = timer.ElapsedMillis();
+
+		timer.Reset();
+		const bool coreAssemblyLoaded = LoadCoreAssembly();
+		const float coreAssemblyTime = timer.ElapsedMillis();
+
+		timer.Reset();
+		const bool appAssemblyLoaded = coreAssemblyLoaded && LoadAppAssembly();
+		const float appAssemblyTime = timer.ElapsedMillis();
+
+		if (!appAssemblyLoaded)
+		{
+			HZ_CORE_ERROR("Assembly reload failed, script state will be restored by the next successful reload.");
+			WatchAppAssembly(appAssemblyPath);
 			return;
+		}
+
+		timer.Reset();
+		RestoreScriptState(*s_Data->PendingSnapshot);
+		s_Data->PendingSnapshot = nullptr;
+		const float restoreTime = timer.ElapsedMillis();
+
+		HZ_CORE_INFO("Assemblies reloaded in {:.2f}ms (snapshot {:.2f}ms, domain + core assembly {:.2f}ms, app assembly + classes {:.2f}ms, restore {:.2f}ms)",
+			snapshotTime + coreAssemblyTime + appAssemblyTime + restoreTime, snapshotTime, coreAssemblyTime, appAssemblyTime, restoreTime);
+	}
+
+	void ScriptEngine::SnapshotScriptState(ScriptStateSnapshot& snapshot)
+	{
+		for (const auto& [className, scriptClass] : s_Data->EntityClasses)
+		{
+			for (const auto& field : scriptClass->m_Fields)
+				snapshot.FieldOwners[field.Field] = className;
+		}
+
+		snapshot.Instances.reserve(s_Data->EntityInstances.size());
+		for (const auto& [entityId, instance] : s_Data->EntityInstances)
+		{
+			auto& state = snapshot.Instances.emplace_back();
+			state.EntityId = entityId;
+			state.ClassName = instance->m_ScriptClass->GetFullName();
+
+			for (const auto& field : instance->m_ScriptClass->m_Fields)
+			{
+				if (!Utils::IsSnapshotFieldType(field.Type))
+					continue;
+
+				ScriptFieldInstance& fieldInstance = state.Fields.emplace_back();
+				fieldInstance.Field = field;
+				instance->GetFieldValueInternal(field.Handle, fieldInstance.m_Buffer, MAX_SCRIPT_FIELD_BUFFER_SIZE);
+			}
+		}
+
+		// The managed objects die with the domain
+		s_Data->EntityInstances.clear();
+	}
+
+	void ScriptEngine::RestoreScriptState(const ScriptStateSnapshot& snapshot)
+	{
+		// Rebind editor field values to the reloaded fields, dropping the ones that were removed or changed type
+		for (auto& [entityId, fieldMap] : s_Data->EntityScriptFields)
+		{
+			ScriptFieldMap reboundFieldMap;
+			for (const ScriptFieldInstance& fieldInstance : fieldMap)
+			{
+				const auto ownerIt = snapshot.FieldOwners.find(fieldInstance.Field.Field);
+				Ref<ScriptClass> scriptClass = ownerIt != snapshot.FieldOwners.end() ? GetEntityClass(ownerIt->second) : nullptr;
+				if (scriptClass)
+				{
+					const ScriptFieldHandle handle = scriptClass->FindField(fieldInstance.Field.Name);
+					if (handle != INVALID_SCRIPT_FIELD_HANDLE && scriptClass->GetField(handle).Type == fieldInstance.Field.Type)
+					{
+						ScriptFieldInstance& reboundInstance = reboundFieldMap.Emplace(scriptClass->GetField(handle));
+						memcpy(reboundInstance.m_Buffer, fieldInstance.m_Buffer, MAX_SCRIPT_FIELD_BUFFER_SIZE);
+						continue;
+					}
+				}
+
+				HZ_CORE_WARN("Script field '{}' of entity {} no longer exists, discarding its value", fieldInstance.Field.Name, entityId);
+			}
+
+			fieldMap = std::move(reboundFieldMap);
+		}
+
+		// Recreate the running instances with the values they had before the reload. OnCreate is not invoked again
+		for (const auto& state : snapshot.Instances)
+		{
+			Ref<ScriptClass> scriptClass = GetEntityClass(state.ClassName);
+			if (!scriptClass)
+			{
+				HZ_CORE_WARN("Script class '{}' no longer exists, entity {} will not be updated", state.ClassName, state.EntityId);
+				continue;
+			}
+
+			auto instance = CreateRef<ScriptInstance>(scriptClass, state.EntityId);
+			for (const auto& fieldInstance : state.Fields)
+			{
+				const ScriptFieldHandle handle = scriptClass->FindField(fieldInstance.Field.Name);
+				if (handle != INVALID_SCRIPT_FIELD_HANDLE && scriptClass->GetField(handle).Type == fieldInstance.Field.Type)
+					instance->SetFieldValueInternal(handle, fieldInstance.m_Buffer, MAX_SCRIPT_FIELD_BUFFER_SIZE);
+			}
+
+			s_Data->EntityInstances[state.EntityId] = instance;
+		}
 	}
 
 	bool ScriptEngine::EntityClassExists(const std::string& fullClassName)
@@ -301,6 +531,7 @@ namespace Hazel
 	{
 		s_Data->SceneContext = nullptr;
 		s_Data->EntityInstances.clear();
+		ClearStringCache();
 	}
 
 	void ScriptEngine::OnCreateEntity(Entity entity)
@@ -317,8 +548,13 @@ namespace Hazel
 			if (it != s_Data->EntityScriptFields.end())
 			{
 				const ScriptFieldMap& fieldMap = it->second;
-				for (const auto& [name, fieldInstance] : fieldMap)
-					instance->SetFieldValueInternal(name, fieldInstance.m_Buffer);
+				const Ref<ScriptClass>& scriptClass = instance->GetScriptClass();
+				for (const auto& fieldInstance : fieldMap)
+				{
+					// Editor values of reference fields hold serialized data (e.g. an entity UUID), not a managed reference
+					if (scriptClass->OwnsField(fieldInstance.Field) && !Utils::IsReferenceFieldType(fieldInstance.Field.Type))
+						instance->SetFieldValueInternal(fieldInstance.Field.Handle, fieldInstance.m_Buffer, MAX_SCRIPT_FIELD_BUFFER_SIZE);
+				}
 			}
 
 			instance->InvokeOnCreate();
@@ -347,7 +583,10 @@ namespace Hazel
 
 	void ScriptEngine::LoadAssemblyClasses()
 	{
+		// Classes whose fields did not change keep their ScriptClass and are only rebound to the reloaded MonoClass
+		auto previousClasses = std::move(s_Data->EntityClasses);
 		s_Data->EntityClasses.clear();
+		uint32_t unchangedCount = 0, changedCount = 0, addedCount = 0;
 
 		const MonoTableInfo* typeDefinitionsTables = mono_image_get_table_info(s_Data->AppAssemblyImage, MONO_TABLE_TYPEDEF);
 		const int32_t numTypes = mono_table_info_get_rows(typeDefinitionsTables);
@@ -372,25 +611,61 @@ namespace Hazel
 
 			std::string fullName = strlen(nameSpace) != 0 ? fmt::format("{}.{}", nameSpace, className) : className;
 
-			Ref<ScriptClass> scriptClass = CreateRef<ScriptClass>(nameSpace, className);
-			s_Data->EntityClasses[fullName] = scriptClass;
-
-			int fieldCount = mono_class_num_fields(monoClass);
-			HZ_CORE_WARN("{} has {} fields:", className, fieldCount);
+			std::vector<ScriptField> fields;
 			void* iterator = nullptr;
 			while (MonoClassField* field = mono_class_get_fields(monoClass, &iterator))
 			{
 				const char* fieldName = mono_field_get_name(field);
 				uint32_t flags = mono_field_get_flags(field);
+
+				// Only instance fields live at an offset inside the object, static and const ones are left out
+				if (flags & (FIELD_ATTRIBUTE_STATIC | FIELD_ATTRIBUTE_LITERAL))
+					continue;
+
 				if (flags & FIELD_ATTRIBUTE_PUBLIC)
 				{
 					MonoType* type = mono_field_get_type(field);
-					ScriptFieldType fieldType = Utils::MonoTypeToScriptFieldType(type);
-					HZ_CORE_WARN("    {} ({})", fieldName, Utils::ScriptFieldTypeToString(fieldType));
-					scriptClass->m_Fields[fieldName] = { fieldName, fieldType, field };
+					int alignment;
+
+					ScriptField& scriptField = fields.emplace_back();
+					scriptField.Name = fieldName;
+					scriptField.Type = Utils::MonoTypeToScriptFieldType(type);
+					scriptField.Field = field;
+					scriptField.Offset = mono_field_get_offset(field);
+					scriptField.Size = (uint32_t)mono_type_size(type, &alignment);
 				}
 			}
+
+			std::sort(fields.begin(), fields.end(), [](const ScriptField& a, const ScriptField& b) { return a.Name < b.Name; });
+			for (ScriptFieldHandle handle = 0; handle < fields.size(); handle++)
+				fields[handle].Handle = handle;
+
+			Ref<ScriptClass> scriptClass;
+			const auto previousIt = previousClasses.find(fullName);
+			if (previousIt != previousClasses.end() && Utils::FieldLayoutsMatch(previousIt->second->m_Fields, fields))
+			{
+				scriptClass = previousIt->second;
+				unchangedCount++;
+			}
+			else
+			{
+				scriptClass = CreateRef<ScriptClass>(nameSpace, className);
+				previousIt != previousClasses.end() ? changedCount++ : addedCount++;
+
+				HZ_CORE_WARN("{} has {} fields:", className, fields.size());
+				for (const auto& field : fields)
+					HZ_CORE_WARN("    {} ({})", field.Name, Utils::ScriptFieldTypeToString(field.Type));
+			}
+
+			if (previousIt != previousClasses.end())
+				previousClasses.erase(previousIt);
+
+			scriptClass->m_MonoClass = monoClass;
+			scriptClass->m_Fields = std::move(fields);
+			s_Data->EntityClasses[fullName] = scriptClass;
 		}
+
+		HZ_CORE_INFO("Script classes: {} unchanged, {} changed, {} added, {} removed", unchangedCount, changedCount, addedCount, previousClasses.size());
 	}
 
 	MonoImage* ScriptEngine::GetCoreAssemblyImage()
@@ -410,6 +685,31 @@ namespace Hazel
 		return s_Data->EntityScriptFields[entity.GetUUID()];
 	}
 
+	void ScriptEngine::SetSerializedFieldValues(Entity entity, const std::vector<SerializedScriptField>& fields)
+	{
+		if (fields.empty() || !entity.HasComponent<ScriptComponent>())
+			return;
+
+		const auto& className = entity.GetComponent<ScriptComponent>().ClassName;
+		Ref<ScriptClass> entityClass = GetEntityClass(className);
+		if (!entityClass)
+			return;
+
+		ScriptFieldMap& fieldMap = GetScriptFieldMap(entity);
+		for (const auto& serializedField : fields)
+		{
+			const ScriptFieldHandle handle = entityClass->FindField(serializedField.Name);
+			if (handle == INVALID_SCRIPT_FIELD_HANDLE || entityClass->GetField(handle).Type != serializedField.Type)
+			{
+				HZ_CORE_WARN("Field '{}' ({}) does not exist in Class '{}'", serializedField.Name, Utils::ScriptFieldTypeToString(serializedField.Type), className);
+				continue;
+			}
+
+			ScriptFieldInstance& fieldInstance = fieldMap.Emplace(entityClass->GetField(handle));
+			memcpy(fieldInstance.m_Buffer, serializedField.Data, MAX_SCRIPT_FIELD_BUFFER_SIZE);
+		}
+	}
+
 	MonoObject* ScriptEngine::GetManagedInstance(UUID uuid)
 	{
 		const auto& scriptInstance = GetEntityScriptInstance(uuid);
@@ -421,6 +721,50 @@ namespace Hazel
 		return mono_string_new(s_Data->AppDomain, string);
 	}
 
+	MonoString* ScriptEngine::CreateString(std::string_view string)
+	{
+		return mono_string_new_len(s_Data->AppDomain, string.data(), (uint32_t)string.size());
+	}
+
+	MonoString* ScriptEngine::GetCachedString(UUID ownerId, std::string_view string)
+	{
+		const auto it = s_Data->StringCache.find(ownerId);
+		if (it != s_Data->StringCache.end() && it->second.Source == string)
+			return (MonoString*)mono_gchandle_get_target(it->second.GCHandle);
+
+		MonoString* monoString = CreateString(string);
+		CacheString(ownerId, string, monoString);
+		return monoString;
+	}
+
+	void ScriptEngine::CacheString(UUID ownerId, std::string_view string, MonoString* monoString)
+	{
+		CachedString& cachedString = s_Data->StringCache[ownerId];
+		if (cachedString.GCHandle)
+			mono_gchandle_free(cachedString.GCHandle);
+
+		cachedString.GCHandle = mono_gchandle_new((MonoObject*)monoString, false);
+		cachedString.Source.assign(string.data(), string.size());
+	}
+
+	void ScriptEngine::ReleaseCachedString(UUID ownerId)
+	{
+		const auto it = s_Data->StringCache.find(ownerId);
+		if (it == s_Data->StringCache.end())
+			return;
+
+		mono_gchandle_free(it->second.GCHandle);
+		s_Data->StringCache.erase(it);
+	}
+
+	void ScriptEngine::ClearStringCache()
+	{
+		for (const auto& [ownerId, cachedString] : s_Data->StringCache)
+			mono_gchandle_free(cachedString.GCHandle);
+
+		s_Data->StringCache.clear();
+	}
+
 	MonoObject* ScriptEngine::InstantiateClass(MonoClass* monoClass)
 	{
 		MonoObject* instance = mono_object_new(s_Data->AppDomain, monoClass);
@@ -428,6 +772,39 @@ namespace Hazel
 		return instance;
 	}
 
+	ScriptFieldInstance* ScriptFieldMap::Find(const ScriptField& field)
+	{
+		return const_cast<ScriptFieldInstance*>(std::as_const(*this).Find(field));
+	}
+
+	const ScriptFieldInstance* ScriptFieldMap::Find(const ScriptField& field) const
+	{
+		const auto it = std::lower_bound(m_Fields.begin(), m_Fields.end(), field.Handle, [](const ScriptFieldInstance& instance, ScriptFieldHandle handle) { return instance.Field.Handle < handle; });
+		if (it == m_Fields.end() || it->Field.Handle != field.Handle || it->Field.Field != field.Field)
+			return nullptr;
+
+		return &*it;
+	}
+
+	ScriptFieldInstance& ScriptFieldMap::Emplace(const ScriptField& field)
+	{
+		auto it = std::lower_bound(m_Fields.begin(), m_Fields.end(), field.Handle, [](const ScriptFieldInstance& instance, ScriptFieldHandle handle) { return instance.Field.Handle < handle; });
+		if (it != m_Fields.end() && it->Field.Handle == field.Handle)
+		{
+			// Same slot bound to a field of another class, the old value means nothing for this one
+			if (it->Field.Field != field.Field)
+			{
+				it->Field = field;
+				memset(it->m_Buffer, 0, MAX_SCRIPT_FIELD_BUFFER_SIZE);
+			}
+			return *it;
+		}
+
+		it = m_Fields.emplace(it);
+		it->Field = field;
+		return *it;
+	}
+
 	ScriptClass::ScriptClass(const std::string& classNamespace, const std::string& className)
 		: m_ClassNamespace(classNamespace), m_ClassName(className)
 	{
@@ -439,6 +816,20 @@ namespace Hazel
 	{
 	}
 
+	ScriptFieldHandle ScriptClass::FindField(std::string_view name) const
+	{
+		const auto it = std::lower_bound(m_Fields.begin(), m_Fields.end(), name, [](const ScriptField& field, std::string_view value) { return field.Name < value; });
+		if (it == m_Fields.end() || it->Name != name)
+			return INVALID_SCRIPT_FIELD_HANDLE;
+
+		return it->Handle;
+	}
+
+	std::string ScriptClass::GetFullName() const
+	{
+		return m_ClassNamespace.empty() ? m_ClassName : fmt::format("{}.{}", m_ClassNamespace, m_ClassName);
+	}
+
 	MonoObject* ScriptClass::Instantiate() const
 	{
 		return ScriptEngine::InstantiateClass(m_MonoClass);
@@ -484,22 +875,18 @@ namespace Hazel
 		}
 	}
 
-	bool ScriptInstance::GetFieldValueInternal(const std::string& name) const
+	void ScriptInstance::GetFieldValueInternal(ScriptFieldHandle handle, void* outValue, size_t size) const
 	{
-		const auto& fields = m_ScriptClass->GetFields();
-		const auto it = fields.find(name);
-		if (it == fields.end())
-			return false;
-
-		mono_field_get_value(m_Instance, it->second.Field, s_FieldValueBuffer);
-		return true;
+		const ScriptField& field = m_ScriptClass->GetField(handle);
+		memcpy(outValue, (const uint8_t*)m_Instance + field.Offset, std::min<size_t>(size, field.Size));
 	}
 
-	void ScriptInstance::SetFieldValueInternal(const std::string& name, const void* value) const
+	void ScriptInstance::SetFieldValueInternal(ScriptFieldHandle handle, const void* value, size_t size) const
 	{
-		const auto& fields = m_ScriptClass->GetFields();
-		const auto it = fields.find(name);
-		if (it != fields.end())
-			mono_field_set_value(m_Instance, it->second.Field, const_cast<void*>(value));
+		const ScriptField& field = m_ScriptClass->GetField(handle);
+		if (Utils::IsReferenceFieldType(field.Type))
+			mono_field_set_value(m_Instance, field.Field, *(MonoObject* const*)value);
+		else
+			memcpy((uint8_t*)m_Instance + field.Offset, value, std::min<size_t>(size, field.Size));
 	}
 }
@@ -2,7 +2,7 @@
 
 #include "Hazel/Core/FileSystem.h"
 
-#include <map>
+#include <limits>
 
 extern "C" {
 	typedef struct _MonoAssembly MonoAssembly;
@@ -34,11 +34,19 @@ namespace Hazel
 		Entity
 	};
 
+	// Index of a field in its ScriptClass field table, resolved once and reused for every access
+	using ScriptFieldHandle = uint32_t;
+	constexpr ScriptFieldHandle INVALID_SCRIPT_FIELD_HANDLE = std::numeric_limits<ScriptFieldHandle>::max();
+
 	struct ScriptField
 	{
 		std::string Name;
 		ScriptFieldType Type;
 		MonoClassField* Field = nullptr;
+
+		ScriptFieldHandle Handle = INVALID_SCRIPT_FIELD_HANDLE;
+		uint32_t Offset = 0; // From the start of the managed object
+		uint32_t Size = 0;
 	};
 
 	struct ScriptFieldInstance
@@ -62,9 +70,49 @@ namespace Hazel
 	private:
 		uint8_t m_Buffer[MAX_SCRIPT_FIELD_BUFFER_SIZE]{0};
 		friend class ScriptEngine;
+		friend class ScriptFieldMap;
+		friend class SceneBinarySerializer;
+	};
+
+	// Values of an entity's script fields set in the editor, sorted by field handle.
+	// Lookups compare handles and the bound field, so values left over from a previous script class are never returned
+	class ScriptFieldMap
+	{
+	public:
+		// Nullptr if the field has no value set
+		ScriptFieldInstance* Find(const ScriptField& field);
+		const ScriptFieldInstance* Find(const ScriptField& field) const;
+
+		// Returns the field's value, adding a zeroed one if it has none
+		ScriptFieldInstance& Emplace(const ScriptField& field);
+
+		void Clear() { m_Fields.clear(); }
+		bool Empty() const { return m_Fields.empty(); }
+
+		std::vector<ScriptFieldInstance>::iterator begin() { return m_Fields.begin(); }
+		std::vector<ScriptFieldInstance>::iterator end() { return m_Fields.end(); }
+		std::vector<ScriptFieldInstance>::const_iterator begin() const { return m_Fields.begin(); }
+		std::vector<ScriptFieldInstance>::const_iterator end() const { return m_Fields.end(); }
+
+	private:
+		std::vector<ScriptFieldInstance> m_Fields;
 	};
 
-	using ScriptFieldMap = std::unordered_map<std::string, ScriptFieldInstance>;
+	// A field value as stored in a scene file. It's only bound to a field, by name, on the main thread
+	// once the entity's script class is known, the class table can change during a hot reload
+	struct SerializedScriptField
+	{
+		std::string Name;
+		ScriptFieldType Type = ScriptFieldType::None;
+		uint8_t Data[MAX_SCRIPT_FIELD_BUFFER_SIZE]{0};
+
+		template<typename T>
+		void SetValue(T value)
+		{
+			static_assert(sizeof(T) <= MAX_SCRIPT_FIELD_BUFFER_SIZE, "Field Type is too large!");
+			memcpy_s(Data, MAX_SCRIPT_FIELD_BUFFER_SIZE, &value, sizeof(T));
+		}
+	};
 
 	class Scene;
 	class Entity;
@@ -82,13 +130,21 @@ namespace Hazel
 		MonoMethod* GetMethod(const std::string& name, int parameterCount) const;
 		MonoObject* InvokeMethod(MonoObject* instance, MonoMethod* method, void** parameters = nullptr);
 
-		const std::map<std::string, ScriptField>& GetFields() const { return m_Fields; }
+		// Sorted by name, a field's handle is its index in this table
+		const std::vector<ScriptField>& GetFields() const { return m_Fields; }
+		const ScriptField& GetField(ScriptFieldHandle handle) const { return m_Fields[handle]; }
+		ScriptFieldHandle FindField(std::string_view name) const;
+
+		// Whether field was resolved from this class, guards values stored for a different class
+		bool OwnsField(const ScriptField& field) const { return field.Handle < m_Fields.size() && m_Fields[field.Handle].Field == field.Field; }
+
+		std::string GetFullName() const;
 
 	private:
 		std::string m_ClassNamespace;
 		std::string m_ClassName;
 
-		std::map<std::string, ScriptField> m_Fields;
+		std::vector<ScriptField> m_Fields;
 
 		MonoClass* m_MonoClass = nullptr;
 
@@ -106,25 +162,26 @@ namespace Hazel
 		Ref<ScriptClass> GetScriptClass() const { return m_ScriptClass; }
 
 		template<typename T>
-		T GetFieldValue(const std::string& name)
+		T GetFieldValue(ScriptFieldHandle handle) const
 		{
 			static_assert(sizeof(T) <= MAX_SCRIPT_FIELD_BUFFER_SIZE, "Field Type is too large!");
-			bool success = GetFieldValueInternal(name);
-			return success ? *(T*)s_FieldValueBuffer : T();
+			T value{};
+			GetFieldValueInternal(handle, &value, sizeof(T));
+			return value;
 		}
 
 		template<typename T>
-		void SetFieldValue(const std::string& name, const T& value)
+		void SetFieldValue(ScriptFieldHandle handle, const T& value) const
 		{
 			static_assert(sizeof(T) <= MAX_SCRIPT_FIELD_BUFFER_SIZE, "Field Type is too large!");
-			SetFieldValueInternal(name, &value);
+			SetFieldValueInternal(handle, &value, sizeof(T));
 		}
 
 		MonoObject* GetManagedObject() const { return m_Instance; }
 
 	private:
-		bool GetFieldValueInternal(const std::string& name) const;
-		void SetFieldValueInternal(const std::string& name, const void* value) const;
+		void GetFieldValueInternal(ScriptFieldHandle handle, void* outValue, size_t size) const;
+		void SetFieldValueInternal(ScriptFieldHandle handle, const void* value, size_t size) const;
 
 	private:
 		Ref<ScriptClass> m_ScriptClass;
@@ -134,11 +191,11 @@ namespace Hazel
 		MonoMethod* m_OnCreateMethod = nullptr;
 		MonoMethod* m_OnUpdateMethod = nullptr;
 
-		inline static uint8_t s_FieldValueBuffer[MAX_SCRIPT_FIELD_BUFFER_SIZE];
-
 		friend class ScriptEngine;
 	};
 
+	struct ScriptStateSnapshot;
+
 	class ScriptEngine
 	{
 	public:
@@ -164,10 +221,20 @@ namespace Hazel
 		static Ref<ScriptInstance> GetEntityScriptInstance(UUID uuid);
 
 		static ScriptFieldMap& GetScriptFieldMap(Entity entity);
+		// Binds serialized values to the fields of the entity's script class and stores them in its field map.
+		// Fields that no longer exist or changed type are skipped
+		static void SetSerializedFieldValues(Entity entity, const std::vector<SerializedScriptField>& fields);
 
 		static MonoObject* GetManagedInstance(UUID uuid);
 
 		static MonoString* CreateString(const char* string);
+		static MonoString* CreateString(std::string_view string);
+
+		// Returns the managed string last cached for ownerId if its contents still match, otherwise creates and caches a new one
+		static MonoString* GetCachedString(UUID ownerId, std::string_view string);
+		static void CacheString(UUID ownerId, std::string_view string, MonoString* monoString);
+		// Lets the GC collect the string cached for ownerId, called when the owner is destroyed
+		static void ReleaseCachedString(UUID ownerId);
 
 	private:
 		static void InitMono();
@@ -176,6 +243,12 @@ namespace Hazel
 		static MonoObject* InstantiateClass(MonoClass* monoClass);
 		static void LoadAssemblyClasses();
 
+		static void ClearStringCache();
+
+		// Captures live instance field values and rebinds editor field maps around an assembly reload
+		static void SnapshotScriptState(ScriptStateSnapshot& snapshot);
+		static void RestoreScriptState(const ScriptStateSnapshot& snapshot);
+
 		friend class ScriptClass;
 		friend class ScriptRegistry;
 	};
@@ -8,6 +8,7 @@
 #include "Hazel/Scripting/ScriptEngine.h"
 #include "Hazel/Physics/Physics2D.h"
 
+#include <mono/metadata/appdomain.h>
 #include <mono/metadata/object.h>
 #include <mono/metadata/reflection.h>
 
@@ -19,16 +20,60 @@ namespace Hazel
 {
 	namespace Utils
 	{
-		std::string MonoStringToString(MonoString* string)
+		// Reads the managed UTF-16 characters in place and encodes them as UTF-8 into outString, reusing its storage
+		void MonoStringToString(MonoString* string, std::string& outString)
 		{
-			char* cStr = mono_string_to_utf8(string);
-			std::string str(cStr);
-			mono_free(cStr);
-			return str;
+			outString.clear();
+			if (!string)
+				return;
+
+			const mono_unichar2* chars = mono_string_chars(string);
+			const int32_t length = mono_string_length(string);
+			outString.reserve(length);
+
+			for (int32_t i = 0; i < length; i++)
+			{
+				uint32_t codepoint = chars[i];
+
+				// Surrogate pair
+				if (codepoint >= 0xD800 && codepoint <= 0xDBFF && i + 1 < length && chars[i + 1] >= 0xDC00 && chars[i + 1] <= 0xDFFF)
+				{
+					codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (chars[i + 1] - 0xDC00);
+					i++;
+				}
+
+				if (codepoint < 0x80)
+				{
+					outString.push_back((char)codepoint);
+				}
+				else if (codepoint < 0x800)
+				{
+					outString.push_back((char)(0xC0 | (codepoint >> 6)));
+					outString.push_back((char)(0x80 | (codepoint & 0x3F)));
+				}
+				else if (codepoint < 0x10000)
+				{
+					outString.push_back((char)(0xE0 | (codepoint >> 12)));
+					outString.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+					outString.push_back((char)(0x80 | (codepoint & 0x3F)));
+				}
+				else
+				{
+					outString.push_back((char)(0xF0 | (codepoint >> 18)));
+					outString.push_back((char)(0x80 | ((codepoint >> 12) & 0x3F)));
+					outString.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+					outString.push_back((char)(0x80 | (codepoint & 0x3F)));
+				}
+			}
 		}
 	}
 
-	static std::unordered_map<MonoType*, std::function<bool(Entity&)>> s_EntityHasComponentFunctions;
+	using HasComponentFn = bool(*)(Entity&);
+
+	// Component type ids are indices into s_EntityHasComponentFunctions.
+	// They are resolved once per managed type so HasComponent never has to go through reflection.
+	static std::unordered_map<MonoType*, int32_t> s_ComponentTypeIds;
+	static std::vector<HasComponentFn> s_EntityHasComponentFunctions;
 
 	static Entity GetEntity(UUID entityId)
 	{
@@ -39,27 +84,69 @@ namespace Hazel
 		return entity;
 	}
 
-	static bool Entity_HasComponent(uint64_t entityId, MonoReflectionType* componentType)
+	static int32_t Entity_GetComponentTypeId(MonoReflectionType* componentType)
 	{
-		Entity entity = GetEntity(entityId);
 		MonoType* managedType = mono_reflection_type_get_type(componentType);
 
-		HZ_CORE_ASSERT(s_EntityHasComponentFunctions.find(managedType) != s_EntityHasComponentFunctions.end());
-		return s_EntityHasComponentFunctions.at(managedType)(entity);
+		const auto it = s_ComponentTypeIds.find(managedType);
+		HZ_CORE_ASSERT(it != s_ComponentTypeIds.end());
+		return it != s_ComponentTypeIds.end() ? it->second : -1;
+	}
+
+	static bool Entity_HasComponent(uint64_t entityId, int32_t componentTypeId)
+	{
+		HZ_CORE_ASSERT(componentTypeId >= 0 && componentTypeId < (int32_t)s_EntityHasComponentFunctions.size());
+		if (componentTypeId < 0 || componentTypeId >= (int32_t)s_EntityHasComponentFunctions.size())
+			return false;
+
+		Entity entity = GetEntity(entityId);
+		return s_EntityHasComponentFunctions[componentTypeId](entity);
+	}
+
+	// Scripts only run on the main thread, so the conversion buffer can be reused between calls
+	static std::string s_NameBuffer;
+
+	static MonoArray* EntitiesToIdArray(const std::vector<Entity>& entities)
+	{
+		MonoArray* ids = mono_array_new(mono_domain_get(), mono_get_uint64_class(), entities.size());
+		for (size_t i = 0; i < entities.size(); i++)
+		{
+			Entity entity = entities[i];
+			mono_array_set(ids, uint64_t, i, (uint64_t)entity.GetUUID());
+		}
+
+		return ids;
 	}
 
 	static uint64_t Entity_FindEntityByName(MonoString* monoString)
 	{
-		char* cStr = mono_string_to_utf8(monoString);
+		Utils::MonoStringToString(monoString, s_NameBuffer);
 
 		Scene* scene = ScriptEngine::GetSceneContext();
 		HZ_CORE_ASSERT(scene);
-		Entity entity = scene->FindEntityByName(cStr);
-		mono_free(cStr);
+		Entity entity = scene->FindEntityByName(s_NameBuffer);
 
 		return entity ? entity.GetUUID() : 0;
 	}
 
+	static MonoArray* Entity_FindEntitiesByName(MonoString* monoString)
+	{
+		Utils::MonoStringToString(monoString, s_NameBuffer);
+
+		Scene* scene = ScriptEngine::GetSceneContext();
+		HZ_CORE_ASSERT(scene);
+		return EntitiesToIdArray(scene->FindEntitiesByName(s_NameBuffer));
+	}
+
+	static MonoArray* Entity_FindEntitiesByNamePrefix(MonoString* monoString)
+	{
+		Utils::MonoStringToString(monoString, s_NameBuffer);
+
+		Scene* scene = ScriptEngine::GetSceneContext();
+		HZ_CORE_ASSERT(scene);
+		return EntitiesToIdArray(scene->FindEntitiesByNamePrefix(s_NameBuffer));
+	}
+
 	static MonoObject* GetScriptInstance(uint64_t entityId)
 	{
 		return ScriptEngine::GetManagedInstance(entityId);
@@ -150,15 +237,19 @@ namespace Hazel
 	{
 		Entity entity = GetEntity(entityId);
 		HZ_CORE_ASSERT(entity.HasComponent<TextComponent>())
-		auto& str = entity.GetComponent<TextComponent>().TextString;
-		return ScriptEngine::CreateString(str.c_str());
+		const auto& str = entity.GetComponent<TextComponent>().TextString;
+		return ScriptEngine::GetCachedString(entityId, str);
 	}
 
 	static void TextComponent_SetText(uint64_t entityId, MonoString* monoString)
 	{
 		Entity entity = GetEntity(entityId);
 		HZ_CORE_ASSERT(entity.HasComponent<TextComponent>())
-		entity.GetComponent<TextComponent>().TextString = Utils::MonoStringToString(monoString);
+		auto& str = entity.GetComponent<TextComponent>().TextString;
+		Utils::MonoStringToString(monoString, str);
+
+		// The managed string now matches the component, hand it back on the next get instead of allocating a new one
+		ScriptEngine::CacheString(entityId, str, monoString);
 	}
 
 	static float TextComponent_GetKerning(uint64_t entityId)
@@ -228,7 +319,8 @@ namespace Hazel
 					return;
 				}
 
-				s_EntityHasComponentFunctions[managedType] = [](Entity& entity) { return entity.HasComponent<Component>(); };
+				s_ComponentTypeIds[managedType] = (int32_t)s_EntityHasComponentFunctions.size();
+				s_EntityHasComponentFunctions.emplace_back([](Entity& entity) { return entity.HasComponent<Component>(); });
 			}(), ...);
 	}
 
@@ -240,14 +332,18 @@ namespace Hazel
 
 	void ScriptRegistry::RegisterComponents()
 	{
+		s_ComponentTypeIds.clear();
 		s_EntityHasComponentFunctions.clear();
 		RegisterComponent(AllComponents{});
 	}
 
 	void ScriptRegistry::RegisterMethods()
 	{
+		HZ_ADD_INTERNAL_CALL(Entity_GetComponentTypeId)
 		HZ_ADD_INTERNAL_CALL(Entity_HasComponent)
 		HZ_ADD_INTERNAL_CALL(Entity_FindEntityByName)
+		HZ_ADD_INTERNAL_CALL(Entity_FindEntitiesByName)
+		HZ_ADD_INTERNAL_CALL(Entity_FindEntitiesByNamePrefix)
 		HZ_ADD_INTERNAL_CALL(GetScriptInstance)
 
 		HZ_ADD_INTERNAL_CALL(TransformComponent_GetPosition)
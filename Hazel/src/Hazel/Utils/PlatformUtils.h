@@ -11,4 +11,11 @@ namespace Hazel
 		static std::optional<std::string> OpenFile(const char* filter);
 		static std::optional<std::string> SaveFile(const char* filter);
 	};
+
+	class ProcessInfo
+	{
+	public:
+		// Highest working set the process has reached so far, in bytes
+		static uint64_t GetPeakMemoryUsage();
+	};
 }
\ No newline at end of file
@@ -215,6 +215,32 @@ namespace Hazel
 		return pixelData;
 	}
 
+	Ref<FramebufferReadback> OpenGLFramebuffer::ReadPixelsAsync(uint32_t attachmentIndex, int32_t x, int32_t y, uint32_t width, uint32_t height)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
+		HZ_CORE_ASSERT(m_ColorAttachmentSpecifications[attachmentIndex].TextureFormat == FramebufferTextureFormat::RED_INTEGER, "Only integer attachments can be read back");
+
+		const int32_t minX = std::max(x, 0);
+		const int32_t minY = std::max(y, 0);
+		const int32_t maxX = std::min(x + (int32_t)width, (int32_t)m_Specification.Width);
+		const int32_t maxY = std::min(y + (int32_t)height, (int32_t)m_Specification.Height);
+		if (minX >= maxX || minY >= maxY)
+			return nullptr;
+
+		// Only the read binding changes so this works in the middle of a render pass too
+		GLint previousReadFramebuffer;
+		glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousReadFramebuffer);
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, m_RendererId);
+		glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
+		auto readback = CreateRef<OpenGLFramebufferReadback>(minX, minY, (uint32_t)(maxX - minX), (uint32_t)(maxY - minY));
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)previousReadFramebuffer);
+
+		return readback;
+	}
+
 	void OpenGLFramebuffer::ClearAttachment(uint32_t attachmentIndex, int32_t value)
 	{
 		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
@@ -222,4 +248,47 @@ namespace Hazel
 		auto& spec = m_ColorAttachmentSpecifications[attachmentIndex];
 		glClearTexImage(m_ColorAttachments[attachmentIndex], 0, Utils::HazelFBTextureFormatToGL(spec.TextureFormat), GL_INT, &value);
 	}
+
+	OpenGLFramebufferReadback::OpenGLFramebufferReadback(int32_t x, int32_t y, uint32_t width, uint32_t height)
+		: m_Width(width), m_Height(height)
+	{
+		const GLsizeiptr size = (GLsizeiptr)width * height * sizeof(int32_t);
+		glCreateBuffers(1, &m_PixelBuffer);
+		glNamedBufferData(m_PixelBuffer, size, nullptr, GL_STREAM_READ);
+
+		// With a pack buffer bound glReadPixels only queues the copy instead of waiting for it
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, m_PixelBuffer);
+		glReadPixels(x, y, (GLsizei)width, (GLsizei)height, GL_RED_INTEGER, GL_INT, nullptr);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		m_Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	OpenGLFramebufferReadback::~OpenGLFramebufferReadback()
+	{
+		if (m_Fence)
+			glDeleteSync((GLsync)m_Fence);
+		glDeleteBuffers(1, &m_PixelBuffer);
+	}
+
+	bool OpenGLFramebufferReadback::IsReady()
+	{
+		if (!m_Fence)
+			return true;
+
+		// Zero timeout, the flush makes sure the fence is submitted at all
+		const GLenum status = glClientWaitSync((GLsync)m_Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+			return false;
+
+		glDeleteSync((GLsync)m_Fence);
+		m_Fence = nullptr;
+
+		m_Pixels.resize((size_t)m_Width * m_Height);
+		glGetNamedBufferSubData(m_PixelBuffer, 0, (GLsizeiptr)(m_Pixels.size() * sizeof(int32_t)), m_Pixels.data());
+
+		glDeleteBuffers(1, &m_PixelBuffer);
+		m_PixelBuffer = 0;
+		return true;
+	}
 }
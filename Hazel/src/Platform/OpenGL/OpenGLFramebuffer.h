@@ -4,6 +4,27 @@
 
 namespace Hazel
 {
+	class OpenGLFramebufferReadback : public FramebufferReadback
+	{
+	public:
+		// Issues the copy, the read framebuffer must be bound with the attachment selected
+		OpenGLFramebufferReadback(int32_t x, int32_t y, uint32_t width, uint32_t height);
+		~OpenGLFramebufferReadback() override;
+
+		bool IsReady() override;
+
+		const std::vector<int32_t>& GetPixels() const override { return m_Pixels; }
+		uint32_t GetWidth() const override { return m_Width; }
+		uint32_t GetHeight() const override { return m_Height; }
+	private:
+		uint32_t m_Width, m_Height;
+		uint32_t m_PixelBuffer = 0;
+		// GLsync, kept opaque so glad doesn't leak into the header
+		void* m_Fence = nullptr;
+
+		std::vector<int32_t> m_Pixels;
+	};
+
 	class OpenGLFramebuffer : public Framebuffer
 	{
 	public:
@@ -17,6 +38,7 @@ namespace Hazel
 
 		void Resize(uint32_t width, uint32_t height) override;
 		int32_t ReadPixel(uint32_t attachmentIndex, int32_t x, int32_t y) override;
+		Ref<FramebufferReadback> ReadPixelsAsync(uint32_t attachmentIndex, int32_t x, int32_t y, uint32_t width, uint32_t height) override;
 
 		void ClearAttachment(uint32_t attachmentIndex, int32_t value) override;
 
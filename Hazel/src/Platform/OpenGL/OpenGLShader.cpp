@@ -10,8 +10,11 @@
 #include <spirv_cross/spirv_cross.hpp>
 #include <spirv_cross/spirv_glsl.hpp>
 
+#include "Hazel/Core/Hash.h"
 #include "Hazel/Core/Timer.h"
 
+#include <future>
+
 namespace Hazel
 {
 	namespace Utils
@@ -23,7 +26,7 @@ namespace Hazel
 			if (type == "fragment" || type == "pixel")
 				return GL_FRAGMENT_SHADER;
 
-			HZ_CORE_ASSERT(false);
+			// Not asserted, a shader being edited may have a typo in it
 			return 0;
 		}
 
@@ -62,9 +65,9 @@ namespace Hazel
 
 		static void CreateCacheDirectoryIfNeeded()
 		{
-			std::string cacheDirectory = GetCacheDirectory();
-			if (!std::filesystem::exists(cacheDirectory))
-				std::filesystem::create_directories(cacheDirectory);
+			// Shaders compile in parallel, so this can race with itself, an existing directory is not an error
+			std::error_code error;
+			std::filesystem::create_directories(GetCacheDirectory(), error);
 		}
 
 		static const char* GLShaderStageCachedOpenGLFileExtension(GLenum stage)
@@ -94,26 +97,197 @@ namespace Hazel
 			HZ_CORE_ASSERT(false);
 			return nullptr;
 		}
-	}
 
-	OpenGLShader::OpenGLShader(const FilePath& filepath)
-		: m_FilePath(filepath)
-	{
-		HZ_PROFILE_FUNCTION();
+		// Bump when the cache file layout or the way the keys are built changes
+		constexpr uint32_t SHADER_CACHE_VERSION = 1;
+		constexpr uint32_t SHADER_CACHE_MAGIC = 0x48535A48; // 'HZSH'
 
-		Utils::CreateCacheDirectoryIfNeeded();
+		struct ShaderCacheHeader
+		{
+			uint32_t Magic = SHADER_CACHE_MAGIC;
+			uint32_t Version = SHADER_CACHE_VERSION;
+			// Hash of everything the binary was built from, a different key means the cached binary is stale
+			uint64_t Key = 0;
+		};
+
+		// Part of the cache keys, these have to describe every option set below
+		constexpr std::string_view VULKAN_COMPILE_OPTIONS = "env=vulkan_1_2;optimization=performance";
+		constexpr std::string_view OPENGL_COMPILE_OPTIONS = "env=opengl_4_5;optimization=performance";
+
+		// The defines only apply to this step, the OpenGL step starts from the already preprocessed Vulkan binary
+		static shaderc::CompileOptions GetVulkanCompileOptions(const std::vector<std::string>& defines)
+		{
+			shaderc::CompileOptions options;
+			options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_2);
+			options.SetOptimizationLevel(shaderc_optimization_level_performance);
+			for (const auto& define : defines)
+				options.AddMacroDefinition(define);
+			return options;
+		}
 
-		std::string source = ReadFile(filepath);
-		auto shaderSources = PreProcess(source);
+		static shaderc::CompileOptions GetOpenGLCompileOptions()
+		{
+			shaderc::CompileOptions options;
+			options.SetTargetEnvironment(shaderc_target_env_opengl, shaderc_env_version_opengl_4_5);
+			options.SetOptimizationLevel(shaderc_optimization_level_performance);
+			return options;
+		}
 
+		static bool ReadCachedBinary(const FilePath& cachedPath, uint64_t key, std::vector<uint32_t>& outData)
 		{
-			Timer timer;
-			CompileOrGetVulkanBinaries(shaderSources);
-			CompileOrGetOpenGLBinaries();
-			CreateProgram();
-			HZ_CORE_TRACE("Shader creation took {0} ms", timer.ElapsedMillis());
+			std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
+			if (!in.is_open())
+				return false;
+
+			in.seekg(0, std::ios::end);
+			const size_t fileSize = in.tellg();
+			in.seekg(0, std::ios::beg);
+
+			if (fileSize <= sizeof(ShaderCacheHeader) || (fileSize - sizeof(ShaderCacheHeader)) % sizeof(uint32_t) != 0)
+				return false;
+
+			ShaderCacheHeader header;
+			in.read((char*)&header, sizeof(ShaderCacheHeader));
+			if (!in || header.Magic != SHADER_CACHE_MAGIC || header.Version != SHADER_CACHE_VERSION || header.Key != key)
+				return false;
+
+			const size_t dataSize = fileSize - sizeof(ShaderCacheHeader);
+			outData.resize(dataSize / sizeof(uint32_t));
+			in.read((char*)outData.data(), dataSize);
+			return (bool)in;
+		}
+
+		// Written to a temporary file and renamed over the entry, so a reader never sees a partial file
+		static void WriteCacheFile(const FilePath& cachedPath, const void* header, size_t headerSize, const void* data, size_t dataSize)
+		{
+			FilePath tempPath = cachedPath;
+			tempPath += ".tmp";
+
+			{
+				std::ofstream out(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+				if (!out.is_open())
+				{
+					HZ_CORE_WARN("Could not write shader cache file {0}", cachedPath);
+					return;
+				}
+
+				out.write((const char*)header, headerSize);
+				out.write((const char*)data, dataSize);
+			}
+
+			std::error_code error;
+			std::filesystem::rename(tempPath, cachedPath, error);
+			if (error)
+			{
+				HZ_CORE_WARN("Could not write shader cache file {0}: {1}", cachedPath, error.message());
+				std::filesystem::remove(tempPath, error);
+			}
+		}
+
+		static void WriteCachedBinary(const FilePath& cachedPath, uint64_t key, const std::vector<uint32_t>& data)
+		{
+			ShaderCacheHeader header;
+			header.Key = key;
+			WriteCacheFile(cachedPath, &header, sizeof(ShaderCacheHeader), data.data(), data.size() * sizeof(uint32_t));
+		}
+
+		constexpr uint32_t PROGRAM_CACHE_VERSION = 1;
+		constexpr uint32_t PROGRAM_CACHE_MAGIC = 0x50535A48; // 'HZSP'
+
+		struct ProgramCacheHeader
+		{
+			uint32_t Magic = PROGRAM_CACHE_MAGIC;
+			uint32_t Version = PROGRAM_CACHE_VERSION;
+			// Hash of the driver and of the linked SPIR-V
+			uint64_t Key = 0;
+			GLenum BinaryFormat = 0;
+			uint32_t BinarySize = 0;
+		};
+
+		static const char* GetCachedProgramFileExtension()
+		{
+			return ".cached_program";
+		}
+
+		static bool IsProgramBinaryCacheSupported()
+		{
+			GLint formatCount = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+			return formatCount > 0;
+		}
+
+		// Program binaries are only valid for the driver that produced them
+		static uint64_t GetDriverKey()
+		{
+			uint64_t key = Hash::FNV_OFFSET_BASIS;
+			for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+			{
+				const char* value = (const char*)glGetString(name);
+				key = Hash::FNV1a(value ? value : "", key);
+			}
+			return key;
+		}
+
+		// Returns 0 when there is no usable binary for this key
+		static GLuint LoadProgramBinary(const FilePath& cachedPath, uint64_t key)
+		{
+			std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
+			if (!in.is_open())
+				return 0;
+
+			ProgramCacheHeader header;
+			in.read((char*)&header, sizeof(ProgramCacheHeader));
+			if (!in || header.Magic != PROGRAM_CACHE_MAGIC || header.Version != PROGRAM_CACHE_VERSION || header.Key != key || header.BinarySize == 0)
+				return 0;
+
+			std::vector<uint8_t> binary(header.BinarySize);
+			in.read((char*)binary.data(), header.BinarySize);
+			if (!in)
+				return 0;
+
+			GLuint program = glCreateProgram();
+			glProgramBinary(program, header.BinaryFormat, binary.data(), header.BinarySize);
+
+			// Drivers are free to reject a binary, e.g. after an update that kept the same version string
+			GLint isLinked;
+			glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+			if (isLinked == GL_FALSE)
+			{
+				glDeleteProgram(program);
+				return 0;
+			}
+
+			return program;
 		}
 
+		static void SaveProgramBinary(GLuint program, const FilePath& cachedPath, uint64_t key)
+		{
+			GLint length = 0;
+			glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+			if (length <= 0)
+				return;
+
+			ProgramCacheHeader header;
+			header.Key = key;
+
+			std::vector<uint8_t> binary(length);
+			glGetProgramBinary(program, length, &length, &header.BinaryFormat, binary.data());
+			header.BinarySize = (uint32_t)length;
+
+			WriteCacheFile(cachedPath, &header, sizeof(ProgramCacheHeader), binary.data(), header.BinarySize);
+		}
+	}
+
+	OpenGLShader::OpenGLShader(const FilePath& filepath, const std::vector<std::string>& defines)
+		: OpenGLShader(filepath, defines, true)
+	{
+	}
+
+	OpenGLShader::OpenGLShader(const FilePath& filepath, const std::vector<std::string>& defines, bool createProgram)
+		: m_FilePath(filepath), m_Defines(defines)
+	{
+		HZ_PROFILE_FUNCTION();
+
 		// Extract name from filepath
 		const auto filePathStr = filepath.string();
 		auto lastSlash = filePathStr.find_last_of("/\\");
@@ -121,6 +295,20 @@ namespace Hazel
 		auto lastDot = filePathStr.rfind('.');
 		auto count = lastDot == std::string::npos ? filePathStr.size() - lastSlash : lastDot - lastSlash;
 		m_Name = filePathStr.substr(lastSlash, count);
+
+		std::string source = ReadFile(filepath);
+		const auto shaderSources = PreProcess(source);
+		if (shaderSources.empty())
+			HZ_CORE_ERROR("Shader '{0}' has no valid stages", filepath);
+
+		// An empty map fails to compile, only the initial load asserts on it
+		m_Compiled = Compile(shaderSources);
+
+		if (createProgram)
+		{
+			HZ_CORE_ASSERT(m_Compiled, "Shader compilation failed!");
+			CreateProgram();
+		}
 	}
 
 	OpenGLShader::OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
@@ -132,13 +320,9 @@ namespace Hazel
 		sources[GL_VERTEX_SHADER] = vertexSrc;
 		sources[GL_FRAGMENT_SHADER] = fragmentSrc;
 
-		{
-			Timer timer;
-			CompileOrGetVulkanBinaries(sources);
-			CompileOrGetOpenGLBinaries();
-			CreateProgram();
-			HZ_CORE_TRACE("Shader creation took {0} ms", timer.ElapsedMillis());
-		}
+		m_Compiled = Compile(sources);
+		HZ_CORE_ASSERT(m_Compiled, "Shader compilation failed!");
+		CreateProgram();
 	}
 
 	OpenGLShader::~OpenGLShader()
@@ -190,142 +374,252 @@ namespace Hazel
 		size_t pos = source.find(typeToken, 0); // Start of shader type declaration line
 		while (pos != std::string::npos)
 		{
+			// Errors are reported instead of asserted since this also runs when a shader is recompiled while edited
 			size_t eol = source.find_first_of("\r\n", pos); // End of shader type declaration line
-			HZ_CORE_ASSERT(eol != std::string::npos, "Syntax error");
+			if (eol == std::string::npos)
+			{
+				HZ_CORE_ERROR("Shader syntax error: '#type' declaration is not followed by a new line");
+				return {};
+			}
+
 			size_t begin = pos + typeTokenLength + 1; // Start of shader type name (after #type keyword)
 			std::string type = source.substr(begin, eol - begin);
-			HZ_CORE_ASSERT(Utils::ShaderTypeFromString(type), "Invalid shader type specified");
+			const GLenum stage = Utils::ShaderTypeFromString(type);
+			if (!stage)
+			{
+				HZ_CORE_ERROR("Invalid shader type '{0}' specified", type);
+				return {};
+			}
 
 			size_t nextLinePos = source.find_first_not_of("\r\n", eol); // Start of shader code after shader type declaration line
-			HZ_CORE_ASSERT(nextLinePos != std::string::npos, "Syntax error");
+			if (nextLinePos == std::string::npos)
+			{
+				HZ_CORE_ERROR("Shader syntax error: '#type {0}' declaration without any code after it", type);
+				return {};
+			}
+
 			pos = source.find(typeToken, nextLinePos); // Start of next shader type declaration line
 			
-			shaderSources[Utils::ShaderTypeFromString(type)] = (pos == std::string::npos) ? source.substr(nextLinePos) : source.substr(nextLinePos, pos - nextLinePos);
+			shaderSources[stage] = (pos == std::string::npos) ? source.substr(nextLinePos) : source.substr(nextLinePos, pos - nextLinePos);
 		}
 
 		return shaderSources;
 	}
 
-	void OpenGLShader::CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string>& shaderSources)
+	std::vector<Ref<OpenGLShader>> OpenGLShader::CreateAll(const std::vector<FilePath>& filepaths, const std::vector<std::string>& defines)
 	{
-		shaderc::Compiler compiler;
-		shaderc::CompileOptions options;
-		options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_2);
-		options.SetOptimizationLevel(shaderc_optimization_level_performance);
+		HZ_PROFILE_FUNCTION();
 
-		FilePath cacheDirectory = Utils::GetCacheDirectory();
+		Timer timer;
 
-		auto& shaderData = m_VulkanSPIRV;
-		shaderData.clear();
+		std::vector<std::future<Ref<OpenGLShader>>> compiling;
+		compiling.reserve(filepaths.size());
+		for (const auto& filepath : filepaths)
+			compiling.push_back(std::async(std::launch::async, [&filepath, &defines] { return Ref<OpenGLShader>(new OpenGLShader(filepath, defines, false)); }));
 
-		for (auto&& [stage, source] : shaderSources)
+		std::vector<Ref<OpenGLShader>> shaders;
+		shaders.reserve(filepaths.size());
+		uint32_t compiledStageCount = 0;
+
+		// Programs are linked in order as their shaders finish compiling, the rest keep compiling meanwhile
+		for (auto& future : compiling)
 		{
-			FilePath shaderFilePath = m_FilePath;
-			FilePath cachedPath = cacheDirectory / (shaderFilePath.filename().string() + Utils::GLShaderStageCachedVulkanFileExtension(stage));
+			Ref<OpenGLShader> shader = future.get();
+			HZ_CORE_ASSERT(shader->m_Compiled, "Shader compilation failed!");
+			shader->CreateProgram();
+			compiledStageCount += shader->GetCompiledStageCount();
+			shaders.push_back(shader);
+		}
 
-			std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
-			if (in.is_open())
-			{
-				in.seekg(0, std::ios::end);
-				size_t size = in.tellg();
-				in.seekg(0, std::ios::beg);
+		HZ_CORE_INFO("Created {0} shaders in {1:.2f} ms ({2} start, {3} stages compiled)",
+			shaders.size(), timer.ElapsedMillis(), compiledStageCount > 0 ? "cold" : "warm", compiledStageCount);
 
-				auto& data = shaderData[stage];
-				data.resize(size / sizeof(uint32_t));
-				in.read((char*)data.data(), size);
-			}
-			else
-			{
-				shaderc::SpvCompilationResult result = compiler.CompileGlslToSpv(source, Utils::GLShaderStageToShaderC(stage), m_FilePath.string().c_str(), options);
-				if (result.GetCompilationStatus() != shaderc_compilation_status_success)
-				{
-					HZ_CORE_ERROR(result.GetErrorMessage());
-					HZ_CORE_ASSERT(false);
-				}
+		return shaders;
+	}
 
-				shaderData[stage] = std::vector(result.cbegin(), result.cend());
+	std::string OpenGLShader::GetCacheName() const
+	{
+		std::string name = m_FilePath.empty() ? m_Name : m_FilePath.filename().string();
+		for (const auto& define : m_Defines)
+			name += "." + define;
+		return name;
+	}
 
-				std::ofstream out(cachedPath, std::ios::out | std::ios::binary);
-				if (out.is_open())
-				{
-					auto& data = shaderData[stage];
-					out.write((char*)data.data(), data.size() * sizeof(uint32_t));
-					out.flush();
-					out.close();
-				}
+	bool OpenGLShader::Compile(const std::unordered_map<GLenum, std::string>& shaderSources)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		Timer timer;
+
+		Utils::CreateCacheDirectoryIfNeeded();
+
+		// The stages don't depend on each other, each one goes from GLSL to OpenGL SPIR-V on its own thread
+		std::vector<std::pair<GLenum, std::future<StageBinaries>>> stages;
+		stages.reserve(shaderSources.size());
+		for (auto&& [stage, source] : shaderSources)
+			stages.emplace_back(stage, std::async(std::launch::async, &OpenGLShader::CompileOrGetStageBinaries, this, stage, std::cref(source)));
+
+		m_VulkanSPIRV.clear();
+		m_OpenGLSPIRV.clear();
+		m_OpenGLSourceCode.clear();
+
+		bool succeeded = !shaderSources.empty();
+		for (auto& [stage, future] : stages)
+		{
+			StageBinaries binaries = future.get();
+			if (binaries.OpenGLSPIRV.empty())
+			{
+				succeeded = false;
+				continue;
 			}
+
+			m_VulkanSPIRV[stage] = std::move(binaries.VulkanSPIRV);
+			m_OpenGLSPIRV[stage] = std::move(binaries.OpenGLSPIRV);
+			if (!binaries.OpenGLSourceCode.empty())
+				m_OpenGLSourceCode[stage] = std::move(binaries.OpenGLSourceCode);
+		}
+
+		if (!succeeded)
+		{
+			HZ_CORE_ERROR("Shader '{0}' failed to compile", m_Name);
+			return false;
 		}
 
 		// TODO move elsewhere
-		for (auto&& [stage, data] : shaderData)
+		for (auto&& [stage, data] : m_VulkanSPIRV)
 			Reflect(stage, data);
+
+		m_CompileTime = timer.ElapsedMillis();
+
+		if (m_CompiledStageCount > 0)
+			HZ_CORE_TRACE("Shader '{0}' compiled in {1:.2f} ms ({2} of {3} stages were not cached)", m_Name, m_CompileTime, m_CompiledStageCount.load(), shaderSources.size());
+		else
+			HZ_CORE_TRACE("Shader '{0}' loaded from cache in {1:.2f} ms", m_Name, m_CompileTime);
+
+		return true;
 	}
 
-	void OpenGLShader::CompileOrGetOpenGLBinaries()
+	OpenGLShader::StageBinaries OpenGLShader::CompileOrGetStageBinaries(GLenum stage, const std::string& source)
 	{
-		auto& shaderData = m_OpenGLSPIRV;
+		StageBinaries binaries;
+		binaries.VulkanSPIRV = CompileOrGetVulkanBinary(stage, source);
+		if (binaries.VulkanSPIRV.empty())
+			return binaries;
 
-		shaderc::Compiler compiler;
-		shaderc::CompileOptions options;
-		options.SetTargetEnvironment(shaderc_target_env_opengl, shaderc_env_version_opengl_4_5);
-		options.SetOptimizationLevel(shaderc_optimization_level_performance);
+		binaries.OpenGLSPIRV = CompileOrGetOpenGLBinary(stage, binaries.VulkanSPIRV, binaries.OpenGLSourceCode);
+		return binaries;
+	}
 
-		FilePath cacheDirectory = Utils::GetCacheDirectory();
+	std::vector<uint32_t> OpenGLShader::CompileOrGetVulkanBinary(GLenum stage, const std::string& source)
+	{
+		HZ_PROFILE_FUNCTION();
 
-		shaderData.clear();
-		m_OpenGLSourceCode.clear();
+		const FilePath cachedPath = FilePath(Utils::GetCacheDirectory()) / (GetCacheName() + Utils::GLShaderStageCachedVulkanFileExtension(stage));
 
-		for (auto&& [stage, spirv] : m_VulkanSPIRV)
+		uint64_t key = Hash::FNV1a(Utils::VULKAN_COMPILE_OPTIONS);
+		for (const auto& define : m_Defines)
 		{
-			FilePath shaderFilePath = m_FilePath;
-			FilePath cachedPath = cacheDirectory / (shaderFilePath.filename().string() + Utils::GLShaderStageCachedOpenGLFileExtension(stage));
+			key = Hash::FNV1a(define, key);
+			// Keeps { "AB" } and { "A", "B" } apart
+			key = Hash::FNV1a(std::string_view(";"), key);
+		}
+		key = Hash::FNV1a(&stage, sizeof(stage), key);
+		key = Hash::FNV1a(source, key);
 
-			std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
-			if (in.is_open())
-			{
-				in.seekg(0, std::ios::end);
-				size_t size = in.tellg();
-				in.seekg(0, std::ios::beg);
+		std::vector<uint32_t> data;
+		if (Utils::ReadCachedBinary(cachedPath, key, data))
+			return data;
 
-				auto& data = shaderData[stage];
-				data.resize(size / sizeof(uint32_t));
-				in.read((char*)data.data(), size);
-			}
-			else
-			{
-				spirv_cross::CompilerGLSL glslCompiler(spirv);
-				m_OpenGLSourceCode[stage] = glslCompiler.compile();
-				auto& source = m_OpenGLSourceCode[stage];
+		// One compiler per call, this runs on several threads at once
+		shaderc::Compiler compiler;
+		shaderc::SpvCompilationResult result = compiler.CompileGlslToSpv(source, Utils::GLShaderStageToShaderC(stage), m_FilePath.string().c_str(), Utils::GetVulkanCompileOptions(m_Defines));
+		if (result.GetCompilationStatus() != shaderc_compilation_status_success)
+		{
+			HZ_CORE_ERROR(result.GetErrorMessage());
+			return {};
+		}
 
-				shaderc::SpvCompilationResult result = compiler.CompileGlslToSpv(source, Utils::GLShaderStageToShaderC(stage), m_FilePath.string().c_str(), options);
-				if (result.GetCompilationStatus() != shaderc_compilation_status_success)
-				{
-					HZ_CORE_ERROR(result.GetErrorMessage());
-					HZ_CORE_ASSERT(false);
-				}
+		data.assign(result.cbegin(), result.cend());
+		m_CompiledStageCount++;
+
+		Utils::WriteCachedBinary(cachedPath, key, data);
+		return data;
+	}
 
-				shaderData[stage] = std::vector(result.cbegin(), result.cend());
+	std::vector<uint32_t> OpenGLShader::CompileOrGetOpenGLBinary(GLenum stage, const std::vector<uint32_t>& vulkanSPIRV, std::string& outSourceCode)
+	{
+		HZ_PROFILE_FUNCTION();
 
-				std::ofstream out(cachedPath, std::ios::out | std::ios::binary);
-				if (out.is_open())
-				{
-					auto& data = shaderData[stage];
-					out.write((char*)data.data(), data.size() * sizeof(uint32_t));
-					out.flush();
-					out.close();
-				}
-			}
+		const FilePath cachedPath = FilePath(Utils::GetCacheDirectory()) / (GetCacheName() + Utils::GLShaderStageCachedOpenGLFileExtension(stage));
+
+		// Keyed on the Vulkan binary, so a change in the source invalidates both caches
+		uint64_t key = Hash::FNV1a(Utils::OPENGL_COMPILE_OPTIONS);
+		key = Hash::FNV1a(&stage, sizeof(stage), key);
+		key = Hash::FNV1a(vulkanSPIRV.data(), vulkanSPIRV.size() * sizeof(uint32_t), key);
+
+		std::vector<uint32_t> data;
+		if (Utils::ReadCachedBinary(cachedPath, key, data))
+			return data;
+
+		spirv_cross::CompilerGLSL glslCompiler(vulkanSPIRV);
+		outSourceCode = glslCompiler.compile();
+
+		shaderc::Compiler compiler;
+		shaderc::SpvCompilationResult result = compiler.CompileGlslToSpv(outSourceCode, Utils::GLShaderStageToShaderC(stage), m_FilePath.string().c_str(), Utils::GetOpenGLCompileOptions());
+		if (result.GetCompilationStatus() != shaderc_compilation_status_success)
+		{
+			HZ_CORE_ERROR(result.GetErrorMessage());
+			return {};
 		}
+
+		data.assign(result.cbegin(), result.cend());
+
+		Utils::WriteCachedBinary(cachedPath, key, data);
+		return data;
 	}
 
 	void OpenGLShader::CreateProgram()
 	{
+		HZ_PROFILE_FUNCTION();
+
+		Timer timer;
+
+		const FilePath cachedPath = FilePath(Utils::GetCacheDirectory()) / (GetCacheName() + Utils::GetCachedProgramFileExtension());
+		const bool useProgramCache = Utils::IsProgramBinaryCacheSupported();
+
+		// Stages are hashed in a fixed order, the map's iteration order is not something to rely on
+		std::vector<GLenum> stages;
+		for (auto&& [stage, spirv] : m_OpenGLSPIRV)
+			stages.push_back(stage);
+		std::sort(stages.begin(), stages.end());
+
+		uint64_t key = Utils::GetDriverKey();
+		for (GLenum stage : stages)
+		{
+			const auto& spirv = m_OpenGLSPIRV.at(stage);
+			key = Hash::FNV1a(&stage, sizeof(stage), key);
+			key = Hash::FNV1a(spirv.data(), spirv.size() * sizeof(uint32_t), key);
+		}
+
+		if (useProgramCache)
+		{
+			if (GLuint program = Utils::LoadProgramBinary(cachedPath, key))
+			{
+				m_RendererId = program;
+				HZ_CORE_TRACE("Shader '{0}' program loaded from the binary cache in {1:.2f} ms", m_Name, timer.ElapsedMillis());
+				return;
+			}
+		}
+
 		GLuint program = glCreateProgram();
+		if (useProgramCache)
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
 		std::vector<GLuint> shaderIds;
 
-		for (auto&& [stage, spirv] : m_OpenGLSPIRV)
+		for (GLenum stage : stages)
 		{
+			const auto& spirv = m_OpenGLSPIRV.at(stage);
 			GLuint shaderId = shaderIds.emplace_back(glCreateShader(stage));
 			glShaderBinary(1, &shaderId, GL_SHADER_BINARY_FORMAT_SPIR_V, spirv.data(), spirv.size() * sizeof(uint32_t));
 			glSpecializeShader(shaderId, "main", 0, nullptr, nullptr);
@@ -349,6 +643,9 @@ namespace Hazel
 
 			for (auto id : shaderIds)
 				glDeleteShader(id);
+
+			m_RendererId = 0;
+			return;
 		}
 
 		for (auto id : shaderIds)
@@ -357,7 +654,61 @@ namespace Hazel
 			glDeleteShader(id);
 		}
 
+		if (useProgramCache)
+			Utils::SaveProgramBinary(program, cachedPath, key);
+
 		m_RendererId = program;
+		HZ_CORE_TRACE("Shader '{0}' program linked in {1:.2f} ms", m_Name, timer.ElapsedMillis());
+	}
+
+	bool OpenGLShader::Recompile()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (m_FilePath.empty())
+		{
+			HZ_CORE_WARN("Shader '{0}' was not loaded from a file and can't be recompiled", m_Name);
+			return false;
+		}
+
+		Ref<OpenGLShader> recompiled(new OpenGLShader(m_FilePath, m_Defines, false));
+		if (!recompiled->m_Compiled)
+			return false;
+
+		std::scoped_lock lock(m_RecompileMutex);
+		m_Recompiled = recompiled;
+		return true;
+	}
+
+	void OpenGLShader::ApplyRecompiled()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		Ref<OpenGLShader> recompiled;
+		{
+			std::scoped_lock lock(m_RecompileMutex);
+			recompiled = std::move(m_Recompiled);
+		}
+
+		if (!recompiled)
+			return;
+
+		recompiled->CreateProgram();
+		if (recompiled->m_RendererId == 0)
+		{
+			HZ_CORE_ERROR("Shader '{0}' failed to link, keeping the previous version", m_Name);
+			return;
+		}
+
+		// Everyone holding this shader picks up the new program the next time they bind it
+		glDeleteProgram(m_RendererId);
+		m_RendererId = std::exchange(recompiled->m_RendererId, 0);
+
+		m_VulkanSPIRV = std::move(recompiled->m_VulkanSPIRV);
+		m_OpenGLSPIRV = std::move(recompiled->m_OpenGLSPIRV);
+		m_OpenGLSourceCode = std::move(recompiled->m_OpenGLSourceCode);
+
+		HZ_CORE_INFO("Reloaded shader '{0}'", m_Name);
 	}
 
 	void OpenGLShader::Reflect(GLenum stage, const std::vector<uint32_t>& shaderData)
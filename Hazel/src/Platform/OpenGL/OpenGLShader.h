@@ -3,6 +3,9 @@
 #include "Hazel/Renderer/Shader.h"
 #include <glm/glm.hpp>
 
+#include <atomic>
+#include <mutex>
+
 using GLenum = uint32_t;
 
 namespace Hazel
@@ -10,10 +13,13 @@ namespace Hazel
 	class OpenGLShader : public Shader
 	{
 	public:
-		OpenGLShader(const FilePath& filepath);
+		OpenGLShader(const FilePath& filepath, const std::vector<std::string>& defines = {});
 		OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
 		~OpenGLShader() override;
 
+		// Compiles all the shaders in parallel on worker threads, their programs are then created on the calling thread
+		static std::vector<Ref<OpenGLShader>> CreateAll(const std::vector<FilePath>& filepaths, const std::vector<std::string>& defines = {});
+
 		void Bind() const override;
 		void Unbind() const override;
 
@@ -26,6 +32,13 @@ namespace Hazel
 		void SetMat4(const std::string& name, const glm::mat4& value) override;
 		
 		const std::string& GetName() const override { return m_Name; }
+		const FilePath& GetFilePath() const override { return m_FilePath; }
+
+		bool Recompile() override;
+		void ApplyRecompiled() override;
+
+		// Number of stages that were not in the cache, or whose cache was stale, and had to be compiled
+		uint32_t GetCompiledStageCount() const { return m_CompiledStageCount; }
 
 		void UploadUniformInt(const std::string& name, const int32_t value) const;
 		void UploadUniformIntArray(const std::string& name, const int32_t* values, const uint32_t count) const;
@@ -38,22 +51,47 @@ namespace Hazel
 		void UploadUniformMat4(const std::string& name, const glm::mat4& matrix) const;
 
 	private:
+		struct StageBinaries
+		{
+			std::vector<uint32_t> VulkanSPIRV;
+			std::vector<uint32_t> OpenGLSPIRV;
+			std::string OpenGLSourceCode;
+		};
+
+		// Only compiles the binaries, CreateProgram has to be called on the thread that owns the context
+		OpenGLShader(const FilePath& filepath, const std::vector<std::string>& defines, bool createProgram);
+
 		static std::string ReadFile(const FilePath& filepath);
 		static std::unordered_map<GLenum, std::string> PreProcess(const std::string& source);
 
-		void CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string>& shaderSources);
-		void CompileOrGetOpenGLBinaries();
+		// Includes the defines so every variant has its own cache entries
+		std::string GetCacheName() const;
+
+		// Returns false and logs the errors when a stage fails to compile
+		bool Compile(const std::unordered_map<GLenum, std::string>& shaderSources);
+		StageBinaries CompileOrGetStageBinaries(GLenum stage, const std::string& source);
+		std::vector<uint32_t> CompileOrGetVulkanBinary(GLenum stage, const std::string& source);
+		std::vector<uint32_t> CompileOrGetOpenGLBinary(GLenum stage, const std::vector<uint32_t>& vulkanSPIRV, std::string& outSourceCode);
 		void CreateProgram();
 		void Reflect(GLenum stage, const std::vector<uint32_t>& shaderData);
 	
 	private:
-		uint32_t m_RendererId;
+		uint32_t m_RendererId = 0;
 		FilePath m_FilePath;
 		std::string m_Name;
+		std::vector<std::string> m_Defines;
 
 		std::unordered_map<GLenum, std::vector<uint32_t>> m_VulkanSPIRV;
 		std::unordered_map<GLenum, std::vector<uint32_t>> m_OpenGLSPIRV;
 		
 		std::unordered_map<GLenum, std::string> m_OpenGLSourceCode;
+
+		bool m_Compiled = false;
+		std::atomic<uint32_t> m_CompiledStageCount = 0;
+		float m_CompileTime = 0.0f;
+
+		// Built by Recompile on any thread, waiting for ApplyRecompiled on the render thread
+		Ref<OpenGLShader> m_Recompiled;
+		std::mutex m_RecompileMutex;
 	};
 }
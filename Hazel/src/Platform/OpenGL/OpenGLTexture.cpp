@@ -1,7 +1,7 @@
 #include "hzpch.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
 
-#include <stb_image.h>
+#include "Hazel/Renderer/TextureCache.h"
 
 namespace Hazel
 {
@@ -49,67 +49,82 @@ namespace Hazel
 
 		glTextureParameteri(m_RendererId, GL_TEXTURE_WRAP_S, GL_REPEAT);
 		glTextureParameteri(m_RendererId, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+		m_LoadState = TextureLoadState::Loaded;
 	}
 
-	OpenGLTexture2D::OpenGLTexture2D(const FilePath& path)
+	OpenGLTexture2D::OpenGLTexture2D(const FilePath& path, bool loadAsync)
 		: m_Path(path)
 	{
 		HZ_PROFILE_FUNCTION();
-		
-		int32_t width, height, channels;
-		stbi_set_flip_vertically_on_load(1);
-		stbi_uc* data;
-		
+
+		// Async textures are filled in later by the TextureLoader
+		if (loadAsync)
+			return;
+
+		TextureImage image;
+		if (!TextureCache::Import(path, image))
 		{
-			HZ_PROFILE_SCOPE("stbi_load - OpenGLTexture2D::OpenGLTexture2D(const std::string&)");
-			data = stbi_load(path.string().c_str(), &width, &height, &channels, 0);
+			m_LoadState = TextureLoadState::Failed;
+			return;
 		}
+
+		Upload(image.Specification, image.Data, image.MipCount);
+	}
+
+	OpenGLTexture2D::~OpenGLTexture2D()
+	{
+		HZ_PROFILE_FUNCTION();
 		
-		if (data)
-		{
-			m_IsLoaded = true;
+		glDeleteTextures(1, &m_RendererId);
+	}
 
-			m_Width = width;
-			m_Height = height;
+	void OpenGLTexture2D::Upload(const TextureSpecification& specification, const void* data, uint32_t mipCount)
+	{
+		HZ_PROFILE_FUNCTION();
 
-			GLenum internalFormat = 0, dataFormat = 0;
+		if (!data)
+		{
+			m_LoadState = TextureLoadState::Failed;
+			return;
+		}
 
-			if (channels == 4)
-			{
-				internalFormat = GL_RGBA8;
-				dataFormat = GL_RGBA;
-			}
-			else if (channels == 3)
-			{
-				internalFormat = GL_RGB8;
-				dataFormat = GL_RGB;
-			}
+		if (m_RendererId)
+			glDeleteTextures(1, &m_RendererId);
 
-			m_InternalFormat = internalFormat;
-			m_DataFormat = dataFormat;
+		m_Specification = specification;
+		m_Width = specification.Width;
+		m_Height = specification.Height;
+		m_InternalFormat = Utils::HazelImageFormatToGLInternalFormat(specification.Format);
+		m_DataFormat = Utils::HazelImageFormatToGLDataFormat(specification.Format);
 
-			HZ_CORE_ASSERT(internalFormat & dataFormat, "Format not suppoerted!");
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererId);
+		glTextureStorage2D(m_RendererId, mipCount, m_InternalFormat, m_Width, m_Height);
 
-			glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererId);
-			glTextureStorage2D(m_RendererId, 1, internalFormat, m_Width, m_Height);
+		glTextureParameteri(m_RendererId, GL_TEXTURE_MIN_FILTER, mipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTextureParameteri(m_RendererId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-			glTextureParameteri(m_RendererId, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTextureParameteri(m_RendererId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTextureParameteri(m_RendererId, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTextureParameteri(m_RendererId, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-			glTextureParameteri(m_RendererId, GL_TEXTURE_WRAP_S, GL_REPEAT);
-			glTextureParameteri(m_RendererId, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		// Small mips of RGB images have rows that aren't 4 byte aligned
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-			glTextureSubImage2D(m_RendererId, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
+		const uint32_t bytesPerPixel = m_DataFormat == GL_RGBA ? 4 : 3;
+		const auto* level = (const uint8_t*)data;
+		uint32_t width = m_Width, height = m_Height;
+		for (uint32_t mip = 0; mip < mipCount; mip++)
+		{
+			glTextureSubImage2D(m_RendererId, mip, 0, 0, width, height, m_DataFormat, GL_UNSIGNED_BYTE, level);
 
-			stbi_image_free(data);
+			level += (uint64_t)width * height * bytesPerPixel;
+			width = std::max(width / 2, 1u);
+			height = std::max(height / 2, 1u);
 		}
-	}
 
-	OpenGLTexture2D::~OpenGLTexture2D()
-	{
-		HZ_PROFILE_FUNCTION();
-		
-		glDeleteTextures(1, &m_RendererId);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+		m_LoadState = TextureLoadState::Loaded;
 	}
 
 	void OpenGLTexture2D::SetData(void* data, uint32_t size)
@@ -121,6 +136,18 @@ namespace Hazel
 		glTextureSubImage2D(m_RendererId, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
 	}
 
+	void OpenGLTexture2D::SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		HZ_CORE_ASSERT(x + width <= m_Width && y + height <= m_Height, "Region is outside of the texture!");
+
+		// RGB rows are rarely 4 byte aligned
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTextureSubImage2D(m_RendererId, 0, x, y, width, height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
 	void OpenGLTexture2D::Bind(uint32_t slot) const
 	{
 		HZ_PROFILE_FUNCTION();
@@ -4,13 +4,15 @@
 
 #include <glad/glad.h>
 
+#include <atomic>
+
 namespace Hazel
 {
 	class OpenGLTexture2D : public Texture2D
 	{
 	public:
 		OpenGLTexture2D(const TextureSpecification& specification);
-		OpenGLTexture2D(const FilePath& path);
+		OpenGLTexture2D(const FilePath& path, bool loadAsync = false);
 		~OpenGLTexture2D() override;
 
 		const TextureSpecification& GetSpecification() const override { return m_Specification; }
@@ -22,10 +24,13 @@ namespace Hazel
 		const FilePath& GetPath() const override { return m_Path; }
 
 		void SetData(void* data, uint32_t size) override;
+		void SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
 		
 		void Bind(uint32_t slot = 0) const override;
 
-		bool IsLoaded() const override { return m_IsLoaded; }
+		TextureLoadState GetLoadState() const override { return m_LoadState; }
+
+		void Upload(const TextureSpecification& specification, const void* data, uint32_t mipCount = 1) override;
 
 		bool operator==(const Texture& other) const override { return m_RendererId == ((const OpenGLTexture2D&)other).m_RendererId; }
 
@@ -33,9 +38,9 @@ namespace Hazel
 		TextureSpecification m_Specification;
 
 		FilePath m_Path;
-		bool m_IsLoaded = false;
-		uint32_t m_Width, m_Height;
-		uint32_t m_RendererId;
-		GLenum m_InternalFormat, m_DataFormat;
+		std::atomic<TextureLoadState> m_LoadState = TextureLoadState::Loading;
+		uint32_t m_Width = 0, m_Height = 0;
+		uint32_t m_RendererId = 0;
+		GLenum m_InternalFormat = 0, m_DataFormat = 0;
 	};
 }
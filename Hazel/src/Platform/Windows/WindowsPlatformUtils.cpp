@@ -2,6 +2,7 @@
 #include "Hazel/Utils/PlatformUtils.h"
 
 #include <commdlg.h>
+#include <psapi.h>
 #include <GLFW/glfw3.h>
 #define GLFW_EXPOSE_NATIVE_WIN32
 #include <GLFW/glfw3native.h>
@@ -56,4 +57,13 @@ namespace Hazel
 
 		return std::nullopt;
 	}
+
+	uint64_t ProcessInfo::GetPeakMemoryUsage()
+	{
+		PROCESS_MEMORY_COUNTERS counters;
+		if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			return 0;
+
+		return counters.PeakWorkingSetSize;
+	}
 }